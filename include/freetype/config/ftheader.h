@@ -777,6 +777,18 @@
 #define FT_COLOR_H  <freetype/ftcolor.h>
 
 
+  /**************************************************************************
+   *
+   * @macro:
+   *   FT_COVERAGE_H
+   *
+   * @description:
+   *   A macro used in `#include` statements to name the file containing the
+   *   FreeType~2 API which computes and handles charmap coverage sets.
+   */
+#define FT_COVERAGE_H  <freetype/ftcover.h>
+
+
   /**************************************************************************
    *
    * @macro:
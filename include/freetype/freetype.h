@@ -309,6 +309,7 @@ FT_BEGIN_HEADER
    *   FT_Get_Charmap_Index
    *
    *   FT_Get_Char_Index
+   *   FT_Get_Char_Indices
    *   FT_Get_First_Char
    *   FT_Get_Next_Char
    *   FT_Load_Char
@@ -4199,6 +4200,62 @@ FT_BEGIN_HEADER
                      FT_ULong  charcode );
 
 
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Get_Char_Indices
+   *
+   * @description:
+   *   Return the glyph indices of an array of character codes, using the
+   *   currently selected charmap.  This is equivalent to calling
+   *   @FT_Get_Char_Index for each element but considerably faster for
+   *   text strings.
+   *
+   * @input:
+   *   face ::
+   *     A handle to the source face object.
+   *
+   *   count ::
+   *     The number of character codes.
+   *
+   *   charcodes ::
+   *     An array of `count` character codes.  For Unicode charmaps these
+   *     are UTF-32 code points.
+   *
+   * @output:
+   *   gindices ::
+   *     An array of at least `count` elements that receives the glyph
+   *     indices; 0~means 'undefined character code'.
+   *
+   *   afirst_unmapped ::
+   *     If non-NULL, the function stops at the first undefined character
+   *     code and returns its position in this variable; the elements of
+   *     `gindices` after that position are left untouched.  If all
+   *     character codes are defined, the value is `count`.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   If the current charmap is a Unicode charmap and the face has a
+   *   variation selector cmap (see @FT_Face_GetCharVariantIndex), each
+   *   variation selector in `charcodes` selects the corresponding variant
+   *   glyph for the character right before it, if there is one; otherwise
+   *   the default glyph is retained.  The elements of `gindices` for the
+   *   variation selectors themselves are set to~0, and they don't count
+   *   as undefined.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FT_Get_Char_Indices( FT_Face           face,
+                       FT_UInt           count,
+                       const FT_UInt32*  charcodes,
+                       FT_UInt*          gindices,
+                       FT_UInt          *afirst_unmapped );
+
+
   /**************************************************************************
    *
    * @function:
@@ -4325,6 +4382,9 @@ FT_BEGIN_HEADER
    *
    *   * @FT_PARAM_TAG_LCD_FILTER_WEIGHTS (no longer supported).
    *
+   *   * @FT_PARAM_TAG_CHARMAP_TABLES (compiled charmap lookup tables for
+   *     @FT_Get_Char_Index).
+   *
    *   Pass `NULL` as `data` in @FT_Parameter for a given tag to reset the
    *   option and use the library or module default again.
    *
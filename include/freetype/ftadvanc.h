@@ -51,6 +51,7 @@ FT_BEGIN_HEADER
    * @order:
    *   FT_Get_Advance
    *   FT_Get_Advances
+   *   FT_Get_Metrics_Arrays
    *
    */
 
@@ -177,6 +178,65 @@ FT_BEGIN_HEADER
                    FT_Int32   load_flags,
                    FT_Fixed  *padvances );
 
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Get_Metrics_Arrays
+   *
+   * @description:
+   *   Retrieve the advance values and side bearings of all glyphs in an
+   *   @FT_Face.  The values are computed once and cached in the face, so
+   *   that a layout engine can index them directly instead of calling
+   *   @FT_Get_Advance for each glyph.
+   *
+   * @input:
+   *   face ::
+   *     The source @FT_Face handle.
+   *
+   *   load_flags ::
+   *     A set of bit flags similar to those used when calling
+   *     @FT_Load_Glyph.
+   *
+   * @output:
+   *   padvances ::
+   *     A pointer to an array of `face->num_glyphs` advance values, in the
+   *     same format as returned by @FT_Get_Advances.
+   *
+   *   pbearings ::
+   *     A pointer to an array of `face->num_glyphs` side bearings, in the
+   *     same format as the advance values.  If @FT_LOAD_VERTICAL_LAYOUT is
+   *     set, these are the top side bearings, otherwise the left side
+   *     bearings.  Set to `NULL` if the side bearings are not available
+   *     without loading glyphs (see below).  This argument may be `NULL`.
+   *
+   * @return:
+   *   FreeType error code.  0 means success.
+   *
+   * @note:
+   *   The arrays are owned by the face and must not be modified; they are
+   *   valid until the face gets destroyed.  Their contents get recomputed
+   *   by the next call to this function if `load_flags`, the scaling of
+   *   the active size, or the variation coordinates have changed.
+   *
+   *   Side bearings are taken from the 'hmtx' or 'vmtx' table of SFNT-based
+   *   fonts.  They are not available for other font formats, for variation
+   *   fonts (including named instances), and for vertical layouts of fonts
+   *   without a 'vmtx' table.
+   *
+   *   Like @FT_Get_Advances, this function may fail if you use
+   *   @FT_ADVANCE_FLAG_FAST_ONLY and if the corresponding font backend
+   *   doesn't have a quick way to retrieve the advances.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FT_Get_Metrics_Arrays( FT_Face           face,
+                         FT_Int32          load_flags,
+                         const FT_Fixed*  *padvances,
+                         const FT_Fixed*  *pbearings );
+
   /* */
 
 
@@ -110,6 +110,13 @@ FT_BEGIN_HEADER
    *   FTC_Manager_LookupFace
    *   FTC_Manager_LookupSize
    *   FTC_Manager_RemoveFaceID
+   *   FTC_Manager_LockFunc
+   *   FTC_Manager_SetLock
+   *   FTC_Eviction_Policy
+   *   FTC_Manager_SetEvictionPolicy
+   *   FTC_StatsRec
+   *   FTC_Stats
+   *   FTC_Manager_GetStats
    *
    *   FTC_Node
    *   FTC_Node_Unref
@@ -117,15 +124,25 @@ FT_BEGIN_HEADER
    *   FTC_ImageCache
    *   FTC_ImageCache_New
    *   FTC_ImageCache_Lookup
+   *   FTC_ImageCache_LookupGlyphs
+   *   FTC_ImageCache_SetMaxBytes
+   *   FTC_ImageCache_GetStats
    *
    *   FTC_SBit
    *   FTC_SBitCache
    *   FTC_SBitCache_New
    *   FTC_SBitCache_Lookup
+   *   FTC_SBitCache_LookupGlyphs
+   *   FTC_SBitCache_SetMaxBytes
+   *   FTC_SBitCache_GetStats
+   *   FTC_SBitCache_Export
+   *   FTC_SBitCache_Import
    *
    *   FTC_CMapCache
    *   FTC_CMapCache_New
    *   FTC_CMapCache_Lookup
+   *   FTC_CMapCache_SetMaxBytes
+   *   FTC_CMapCache_GetStats
    *
    *************************************************************************/
 
@@ -560,6 +577,257 @@ FT_BEGIN_HEADER
                             FTC_FaceID   face_id );
 
 
+  /**************************************************************************
+   *
+   * @functype:
+   *   FTC_Manager_LockFunc
+   *
+   * @description:
+   *   A callback function provided by client applications to acquire or
+   *   release a lock that serializes access to a cache manager.  See
+   *   @FTC_Manager_SetLock.
+   *
+   * @input:
+   *   lock_data ::
+   *     The `lock_data` pointer passed to @FTC_Manager_SetLock.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef void
+  (*FTC_Manager_LockFunc)( FT_Pointer  lock_data );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_Manager_SetLock
+   *
+   * @description:
+   *   Install client-provided lock functions that make a cache manager and
+   *   all of its caches safe to use from multiple threads.
+   *
+   * @input:
+   *   manager ::
+   *     The cache manager handle.
+   *
+   *   lock ::
+   *     A function to acquire the lock.  Use `NULL` (together with a `NULL`
+   *     `unlock` value) to remove a previously installed lock.
+   *
+   *   unlock ::
+   *     A function to release the lock.
+   *
+   *   lock_data ::
+   *     A generic pointer passed to both `lock` and `unlock`, typically a
+   *     pointer to a mutex.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   FreeType itself doesn't provide any synchronization primitives.
+   *   After this function has been called, all lookup functions of the
+   *   cache sub-system, @FTC_Node_Unref, @FTC_Manager_Reset, and
+   *   @FTC_Manager_RemoveFaceID call `lock` on entry and `unlock` on exit.
+   *   The lock is never acquired recursively, so a plain (non-recursive)
+   *   mutex is sufficient.
+   *
+   *   Cached data, whether glyph images or small bitmaps, is shared among
+   *   all threads.  Since a node with a reference count of~0 can be
+   *   flushed by another thread as soon as the lookup returns, threads
+   *   must always pass a non-`NULL` `anode` argument to
+   *   @FTC_ImageCache_Lookup or @FTC_SBitCache_Lookup (or their `Scaler`
+   *   variants) and call @FTC_Node_Unref after they are done with the
+   *   data.
+   *
+   *   The @FT_Face and @FT_Size objects returned by
+   *   @FTC_Manager_LookupFace and @FTC_Manager_LookupSize are owned by the
+   *   manager and used internally to load glyphs on a cache miss; they
+   *   must only be accessed while holding the lock.
+   *
+   *   Lock functions should be installed, and all caches created with
+   *   @FTC_ImageCache_New, @FTC_SBitCache_New, and @FTC_CMapCache_New,
+   *   before the manager is shared between threads.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_Manager_SetLock( FTC_Manager           manager,
+                       FTC_Manager_LockFunc  lock,
+                       FTC_Manager_LockFunc  unlock,
+                       FT_Pointer            lock_data );
+
+
+  /**************************************************************************
+   *
+   * @enum:
+   *   FTC_Eviction_Policy
+   *
+   * @description:
+   *   An enumeration of the policies a cache manager can use to select the
+   *   nodes to flush if its memory budget is exceeded.
+   *
+   * @values:
+   *   FTC_EVICTION_POLICY_LRU ::
+   *     The default.  Each cache hit moves the node to the head of the
+   *     manager's list, and the least recently used nodes are flushed
+   *     first.
+   *
+   *   FTC_EVICTION_POLICY_CLOCK ::
+   *     The 'second chance' approximation of LRU.  A cache hit only marks
+   *     the node as referenced, which is cheaper than relinking it.  When
+   *     nodes must be flushed, a marked node is unmarked and moved to the
+   *     head of the list instead of being discarded.  Nodes that are hit
+   *     repeatedly thus stay in the cache even if they are never moved up
+   *     on a hit.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef enum  FTC_Eviction_Policy_
+  {
+    FTC_EVICTION_POLICY_LRU = 0,
+    FTC_EVICTION_POLICY_CLOCK,
+
+    FTC_EVICTION_POLICY_MAX
+
+  } FTC_Eviction_Policy;
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_Manager_SetEvictionPolicy
+   *
+   * @description:
+   *   Select the eviction policy of a cache manager.
+   *
+   * @input:
+   *   manager ::
+   *     The cache manager handle.
+   *
+   *   policy ::
+   *     The new policy.  See @FTC_Eviction_Policy.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The policy applies to the nodes of all caches of the manager,
+   *   whether they are flushed to meet the `max_bytes` limit given to
+   *   @FTC_Manager_New or the budget of an individual cache (see, for
+   *   example, @FTC_SBitCache_SetMaxBytes).
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_Manager_SetEvictionPolicy( FTC_Manager          manager,
+                                 FTC_Eviction_Policy  policy );
+
+
+  /**************************************************************************
+   *
+   * @struct:
+   *   FTC_StatsRec
+   *
+   * @description:
+   *   A structure to hold usage statistics of a cache or of a whole cache
+   *   manager.  The counters are always maintained; their cost is
+   *   negligible compared to a lookup.
+   *
+   * @fields:
+   *   lookups ::
+   *     The number of lookups since the cache was created.
+   *
+   *   hits ::
+   *     The number of lookups that could be satisfied from cached data.
+   *
+   *   misses ::
+   *     The number of lookups that had to load data from the font, i.e.,
+   *     `lookups` minus `hits`.  For an @FTC_SBitCache, loading a glyph
+   *     into an already existing node (which holds several glyphs) counts
+   *     as a miss, too.
+   *
+   *   evictions ::
+   *     The number of nodes flushed to stay within the memory budget or
+   *     by @FTC_Manager_Reset.  Nodes removed by @FTC_Manager_RemoveFaceID
+   *     are not counted.
+   *
+   *   num_nodes ::
+   *     The current number of cache nodes.
+   *
+   *   num_bytes ::
+   *     The current amount of memory used by the cache nodes, in bytes.
+   *     This is the value compared with the `max_bytes` limits.
+   *
+   * @note:
+   *   Counters are not reset and may wrap around on platforms with a
+   *   32-bit `FT_ULong` type.  Compute differences between two snapshots
+   *   to get rates.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef struct  FTC_StatsRec_
+  {
+    FT_ULong  lookups;
+    FT_ULong  hits;
+    FT_ULong  misses;
+    FT_ULong  evictions;
+    FT_ULong  num_nodes;
+    FT_ULong  num_bytes;
+
+  } FTC_StatsRec;
+
+
+  /**************************************************************************
+   *
+   * @type:
+   *   FTC_Stats
+   *
+   * @description:
+   *   A handle to an @FTC_StatsRec structure.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef struct FTC_StatsRec_*  FTC_Stats;
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_Manager_GetStats
+   *
+   * @description:
+   *   Retrieve usage statistics summed up over all caches of a manager.
+   *
+   * @input:
+   *   manager ::
+   *     The cache manager handle.
+   *
+   * @output:
+   *   astats ::
+   *     The statistics.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   Use @FTC_ImageCache_GetStats, @FTC_SBitCache_GetStats, or
+   *   @FTC_CMapCache_GetStats to get the values of a single cache.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_Manager_GetStats( FTC_Manager  manager,
+                        FTC_Stats    astats );
+
+
   /**************************************************************************
    *
    * @type:
@@ -636,6 +904,67 @@ FT_BEGIN_HEADER
                         FT_UInt32      char_code );
 
 
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_CMapCache_SetMaxBytes
+   *
+   * @description:
+   *   Limit the memory used by a charmap cache's nodes, independently of
+   *   the other caches of the same manager.
+   *
+   * @input:
+   *   cache ::
+   *     A charmap cache handle.
+   *
+   *   max_bytes ::
+   *     The maximum number of bytes used by the cache's nodes.  Use~0 to
+   *     only apply the manager's global limit (this is the default).
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The global limit given to @FTC_Manager_New stays in effect; the sum
+   *   of all cache budgets should not exceed it if each cache is to get
+   *   its full share.  Nodes exceeding the new budget are flushed
+   *   immediately.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_CMapCache_SetMaxBytes( FTC_CMapCache  cache,
+                             FT_ULong       max_bytes );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_CMapCache_GetStats
+   *
+   * @description:
+   *   Retrieve usage statistics of a charmap cache.
+   *
+   * @input:
+   *   cache ::
+   *     The cache handle.
+   *
+   * @output:
+   *   astats ::
+   *     The statistics.  See @FTC_StatsRec.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_CMapCache_GetStats( FTC_CMapCache  cache,
+                          FTC_Stats      astats );
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
@@ -849,6 +1178,133 @@ FT_BEGIN_HEADER
                                FTC_Node       *anode );
 
 
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_ImageCache_LookupGlyphs
+   *
+   * @description:
+   *   Retrieve a given run of glyph images from a glyph image cache.  This
+   *   is equivalent to calling @FTC_ImageCache_LookupScaler for each glyph
+   *   but faster, since the font, size, and load flags are resolved only
+   *   once.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source glyph image cache.
+   *
+   *   scaler ::
+   *     A pointer to a scaler descriptor.
+   *
+   *   load_flags ::
+   *     The corresponding load flags.
+   *
+   *   num_glyphs ::
+   *     The number of glyph indices in `gindices`.
+   *
+   *   gindices ::
+   *     An array of glyph indices, which may contain duplicates.
+   *
+   * @output:
+   *   aglyphs ::
+   *     An array of `num_glyphs` elements to receive the corresponding
+   *     glyph image handles.  Don't modify or free the glyphs!
+   *
+   *   anodes ::
+   *     Used to return the address of the corresponding cache nodes after
+   *     incrementing their reference counts (see note below).  If not
+   *     `NULL`, this must be an array of `num_glyphs` elements.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The behaviour regarding `anodes` is the same as with
+   *   @FTC_ImageCache_LookupScaler; in particular, @FTC_Node_Unref must be
+   *   called for every element of `anodes`.  All glyphs of the run stay in
+   *   the cache until the function returns, even if their total size
+   *   exceeds the cache's budget.
+   *
+   *   Each element of the run holds its own reference to its cache node,
+   *   and a node's reference count can't exceed 32767.  A run that repeats
+   *   the same glyph index more often fails with `Invalid_Argument`.
+   *
+   *   In case of error, all elements of `aglyphs` and `anodes` are set to
+   *   `NULL` and no node is acquired.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_ImageCache_LookupGlyphs( FTC_ImageCache  cache,
+                               FTC_Scaler      scaler,
+                               FT_ULong        load_flags,
+                               FT_UInt         num_glyphs,
+                               const FT_UInt  *gindices,
+                               FT_Glyph       *aglyphs,
+                               FTC_Node       *anodes );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_ImageCache_SetMaxBytes
+   *
+   * @description:
+   *   Limit the memory used by a glyph image cache's nodes, independently
+   *   of the other caches of the same manager.  This prevents a few large
+   *   outline or color images from flushing small bitmaps held in an
+   *   @FTC_SBitCache.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the glyph image cache object.
+   *
+   *   max_bytes ::
+   *     The maximum number of bytes used by the cache's nodes.  Use~0 to
+   *     only apply the manager's global limit (this is the default).
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   See @FTC_CMapCache_SetMaxBytes.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_ImageCache_SetMaxBytes( FTC_ImageCache  cache,
+                              FT_ULong        max_bytes );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_ImageCache_GetStats
+   *
+   * @description:
+   *   Retrieve usage statistics of a glyph image cache.
+   *
+   * @input:
+   *   cache ::
+   *     The cache handle.
+   *
+   * @output:
+   *   astats ::
+   *     The statistics.  See @FTC_StatsRec.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_ImageCache_GetStats( FTC_ImageCache  cache,
+                           FTC_Stats       astats );
+
+
   /**************************************************************************
    *
    * @type:
@@ -1076,6 +1532,240 @@ FT_BEGIN_HEADER
                               FTC_SBit      *sbit,
                               FTC_Node      *anode );
 
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_SBitCache_LookupGlyphs
+   *
+   * @description:
+   *   Look up a given run of small glyph bitmaps in a given sbit cache.
+   *   This is equivalent to calling @FTC_SBitCache_LookupScaler for each
+   *   glyph but faster, since the font, size, and load flags are resolved
+   *   only once.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source sbit cache.
+   *
+   *   scaler ::
+   *     A pointer to the scaler descriptor.
+   *
+   *   load_flags ::
+   *     The corresponding load flags.
+   *
+   *   num_glyphs ::
+   *     The number of glyph indices in `gindices`.
+   *
+   *   gindices ::
+   *     An array of glyph indices, which may contain duplicates.
+   *
+   * @output:
+   *   asbits ::
+   *     An array of `num_glyphs` elements to receive the corresponding
+   *     sbit handles.
+   *
+   *   anodes ::
+   *     Used to return the address of the corresponding cache nodes after
+   *     incrementing their reference counts (see note below).  If not
+   *     `NULL`, this must be an array of `num_glyphs` elements.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The behaviour regarding `anodes` is the same as with
+   *   @FTC_SBitCache_LookupScaler; in particular, @FTC_Node_Unref must be
+   *   called for every element of `anodes`.
+   *
+   *   Each element of the run holds its own reference to its cache node,
+   *   and a node's reference count can't exceed 32767.  Since a node
+   *   stores several consecutive glyph indices, a run with more than that
+   *   many elements falling into the same node fails with
+   *   `Invalid_Argument`.
+   *
+   *   In case of error, all elements of `asbits` and `anodes` are set to
+   *   `NULL` and no node is acquired.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_SBitCache_LookupGlyphs( FTC_SBitCache   cache,
+                              FTC_Scaler      scaler,
+                              FT_ULong        load_flags,
+                              FT_UInt         num_glyphs,
+                              const FT_UInt  *gindices,
+                              FTC_SBit       *asbits,
+                              FTC_Node       *anodes );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_SBitCache_SetMaxBytes
+   *
+   * @description:
+   *   Limit the memory used by a small bitmap cache's nodes, independently
+   *   of the other caches of the same manager.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the small bitmap cache.
+   *
+   *   max_bytes ::
+   *     The maximum number of bytes used by the cache's nodes.  Use~0 to
+   *     only apply the manager's global limit (this is the default).
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   See @FTC_CMapCache_SetMaxBytes.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_SBitCache_SetMaxBytes( FTC_SBitCache  cache,
+                             FT_ULong       max_bytes );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_SBitCache_GetStats
+   *
+   * @description:
+   *   Retrieve usage statistics of a small bitmap cache.
+   *
+   * @input:
+   *   cache ::
+   *     The cache handle.
+   *
+   * @output:
+   *   astats ::
+   *     The statistics.  See @FTC_StatsRec.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_SBitCache_GetStats( FTC_SBitCache  cache,
+                          FTC_Stats      astats );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_SBitCache_Export
+   *
+   * @description:
+   *   Serialize all small bitmaps of a given face, size, and set of load
+   *   flags that are currently loaded into a small bitmap cache.  The data
+   *   can be stored by the application (for example, in a file) and given
+   *   to @FTC_SBitCache_Import later on, possibly in another process, to
+   *   avoid rendering the glyphs again.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source sbit cache.
+   *
+   *   scaler ::
+   *     A pointer to the scaler descriptor.  Only its `face_id` and size
+   *     fields are compared with the cached bitmaps.
+   *
+   *   load_flags ::
+   *     The corresponding load flags.
+   *
+   *   buffer ::
+   *     The target buffer.  Ignored if `*alength` is zero.
+   *
+   * @inout:
+   *   alength ::
+   *     If the value is zero on input, the number of bytes needed to
+   *     serialize the bitmaps is returned.  Otherwise, it gives the size of
+   *     `buffer` on input and the number of bytes actually written on
+   *     output.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   Bitmaps that do not fit into `buffer` are left out.  Since the cache
+   *   contents may change between two calls (for example, if other threads
+   *   share the cache manager), the size returned in the first call is
+   *   only a hint.
+   *
+   *   The data contains neither the face ID nor the scaler; it is up to
+   *   the application to associate it with the font file (e.g., through a
+   *   checksum), the face index, any variation settings, the size, and the
+   *   load flags.  The data is also tied to the FreeType version that
+   *   created it.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_SBitCache_Export( FTC_SBitCache  cache,
+                        FTC_Scaler     scaler,
+                        FT_ULong       load_flags,
+                        FT_Byte*       buffer,
+                        FT_ULong      *alength );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_SBitCache_Import
+   *
+   * @description:
+   *   Fill a small bitmap cache with bitmaps previously serialized by
+   *   @FTC_SBitCache_Export.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the target sbit cache.
+   *
+   *   scaler ::
+   *     A pointer to the scaler descriptor the bitmaps belong to.
+   *
+   *   load_flags ::
+   *     The corresponding load flags.
+   *
+   *   buffer ::
+   *     The serialized data.
+   *
+   *   length ::
+   *     The size of `buffer` in bytes.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  `FT_Err_Invalid_Version` is
+   *   returned if the data was written by a different version of
+   *   FreeType.
+   *
+   * @note:
+   *   The bitmaps are copied, so `buffer` can be released after the call.
+   *   Glyphs already present in the cache are not replaced.  The imported
+   *   bitmaps count against the cache budgets like any other bitmap; older
+   *   cache entries may thus be flushed.
+   *
+   *   If an error occurs, bitmaps imported before the faulty record stay
+   *   in the cache.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FTC_SBitCache_Import( FTC_SBitCache   cache,
+                        FTC_Scaler      scaler,
+                        FT_ULong        load_flags,
+                        const FT_Byte*  buffer,
+                        FT_ULong        length );
+
   /* */
 
 
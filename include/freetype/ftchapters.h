@@ -38,6 +38,7 @@
    *   sizing_and_scaling
    *   glyph_retrieval
    *   character_mapping
+   *   charmap_coverage
    *   information_retrieval
    *   other_api_data
    *
@@ -0,0 +1,284 @@
+/****************************************************************************
+ *
+ * ftcover.h
+ *
+ *   FreeType API for charmap coverage sets (specification).
+ *
+ * Copyright (C) 2026 by
+ * David Turner, Robert Wilhelm, and Werner Lemberg.
+ *
+ * This file is part of the FreeType project, and may only be used,
+ * modified, and distributed under the terms of the FreeType project
+ * license, LICENSE.TXT.  By continuing to use, modify, or distribute
+ * this file you indicate that you have read the license and
+ * understand and accept it fully.
+ *
+ */
+
+
+#ifndef FTCOVER_H_
+#define FTCOVER_H_
+
+#include <freetype/freetype.h>
+
+#ifdef FREETYPE_H
+#error "freetype.h of FreeType 1 has been loaded!"
+#error "Please fix the directory search order for header files"
+#error "so that freetype.h of FreeType 2 is found first."
+#endif
+
+
+FT_BEGIN_HEADER
+
+
+  /**************************************************************************
+   *
+   * @section:
+   *   charmap_coverage
+   *
+   * @title:
+   *   Charmap Coverage
+   *
+   * @abstract:
+   *   Compact sets of the character codes supported by a charmap.
+   *
+   * @description:
+   *   The functions described here compute the set of character codes
+   *   that a charmap maps to a glyph, store it compactly as a sorted list
+   *   of code ranges, and allow fast membership tests.  Coverage objects
+   *   are independent of the face they have been computed from; they can
+   *   be serialized and loaded again, for example, to build a font
+   *   fallback index once and cache it.
+   *
+   *   For SFNT-based fonts the coverage is computed directly from the
+   *   segments of cmap formats 4, 12, and~13, which is much faster than
+   *   enumerating all character codes with @FT_Get_First_Char and
+   *   @FT_Get_Next_Char.
+   *
+   * @order:
+   *   FT_Coverage
+   *
+   *   FT_Coverage_New
+   *   FT_Coverage_Done
+   *   FT_Coverage_Has_Char
+   *   FT_Coverage_Check_Chars
+   *
+   *   FT_Coverage_Save
+   *   FT_Coverage_Load
+   *
+   */
+
+
+  /**************************************************************************
+   *
+   * @type:
+   *   FT_Coverage
+   *
+   * @description:
+   *   A handle to an opaque object holding a set of character codes.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef struct FT_CoverageRec_*  FT_Coverage;
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Coverage_New
+   *
+   * @description:
+   *   Compute the set of character codes that a charmap maps to a glyph
+   *   index, this is, all character codes for which @FT_Get_Char_Index
+   *   returns a non-zero value if `charmap` is selected.
+   *
+   * @input:
+   *   charmap ::
+   *     A handle to the charmap.
+   *
+   * @output:
+   *   acoverage ::
+   *     A handle to a new coverage object.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   For SFNT cmap formats other than 4, 12, and~13, and for the
+   *   encodings of all other font formats, the coverage is computed by
+   *   enumerating the charmap as @FT_Get_Next_Char does.
+   *
+   *   The object must be destroyed with @FT_Coverage_Done.  It doesn't
+   *   depend on the face of `charmap`, which may be closed before.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FT_Coverage_New( FT_CharMap    charmap,
+                   FT_Coverage  *acoverage );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Coverage_Done
+   *
+   * @description:
+   *   Destroy a coverage object.
+   *
+   * @input:
+   *   coverage ::
+   *     A handle to the coverage object.  Can be `NULL`.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( void )
+  FT_Coverage_Done( FT_Coverage  coverage );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Coverage_Has_Char
+   *
+   * @description:
+   *   Test whether a character code is in a coverage set.
+   *
+   * @input:
+   *   coverage ::
+   *     A handle to the coverage object.
+   *
+   *   charcode ::
+   *     The character code.
+   *
+   * @return:
+   *   True if `charcode` is in the set.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Bool )
+  FT_Coverage_Has_Char( FT_Coverage  coverage,
+                        FT_ULong     charcode );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Coverage_Check_Chars
+   *
+   * @description:
+   *   Intersect a coverage set with an array of character codes, for
+   *   example, a text string.
+   *
+   * @input:
+   *   coverage ::
+   *     A handle to the coverage object.
+   *
+   *   count ::
+   *     The number of character codes.
+   *
+   *   charcodes ::
+   *     An array of `count` character codes.
+   *
+   * @output:
+   *   covered ::
+   *     If non-NULL, an array of at least `count` elements that receives
+   *     for each character code whether it is in the set.
+   *
+   * @return:
+   *   The number of elements of `charcodes` that are in the set.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_UInt )
+  FT_Coverage_Check_Chars( FT_Coverage       coverage,
+                           FT_UInt           count,
+                           const FT_UInt32*  charcodes,
+                           FT_Bool*          covered );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Coverage_Save
+   *
+   * @description:
+   *   Serialize a coverage set into a buffer.
+   *
+   * @input:
+   *   coverage ::
+   *     A handle to the coverage object.
+   *
+   *   buffer ::
+   *     The target buffer.  If `NULL`, only the needed size is returned.
+   *
+   * @inout:
+   *   alength ::
+   *     On input, the size of `buffer` in bytes.  On output, the number of
+   *     bytes needed to serialize `coverage`.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  An error is returned if
+   *   `buffer` is too small.
+   *
+   * @note:
+   *   The data is independent of the platform's endianness and can be
+   *   loaded again with @FT_Coverage_Load.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FT_Coverage_Save( FT_Coverage  coverage,
+                    FT_Byte*     buffer,
+                    FT_ULong    *alength );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Coverage_Load
+   *
+   * @description:
+   *   Create a coverage object from data written by @FT_Coverage_Save.
+   *
+   * @input:
+   *   library ::
+   *     A handle to the library resource.
+   *
+   *   buffer ::
+   *     The serialized data.
+   *
+   *   length ::
+   *     The size of `buffer` in bytes.
+   *
+   * @output:
+   *   acoverage ::
+   *     A handle to a new coverage object.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FT_Coverage_Load( FT_Library      library,
+                    const FT_Byte*  buffer,
+                    FT_ULong        length,
+                    FT_Coverage    *acoverage );
+
+  /* */
+
+
+FT_END_HEADER
+
+#endif /* FTCOVER_H_ */
+
+
+/* END */
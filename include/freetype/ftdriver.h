@@ -80,8 +80,8 @@ FT_BEGIN_HEADER
    *   The CFF driver's module name is 'cff'.
    *
    *   Available properties are @hinting-engine, @no-stem-darkening,
-   *   @darkening-parameters, and @random-seed, as documented in the
-   *   @properties section.
+   *   @darkening-parameters, @random-seed, and @charstring-cache-size, as
+   *   documented in the @properties section.
    *
    *
    *   **Hinting and anti-aliasing principles of the new engine**
@@ -214,8 +214,9 @@ FT_BEGIN_HEADER
    *   itself, it is possible to control its behaviour with @FT_Property_Set
    *   and @FT_Property_Get.
    *
-   *   The TrueType driver's module name is 'truetype'; a single property
-   *   @interpreter-version is available, as documented in the @properties
+   *   The TrueType driver's module name is 'truetype'; the properties
+   *   @interpreter-version, @outline-cache-size, @gvar-cache-size, and
+   *   @prep-cache-stats are available, as documented in the @properties
    *   section.
    *
    *   To help understand the differences between interpreter versions, we
@@ -589,6 +590,53 @@ FT_BEGIN_HEADER
    */
 
 
+  /**************************************************************************
+   *
+   * @property:
+   *   charstring-cache-size
+   *
+   * @description:
+   *   The maximum number of bytes per face the CFF driver may use to cache
+   *   the results of the charstring interpreter.  Glyphs loaded with
+   *   `FT_LOAD_NO_HINTING` (or `FT_LOAD_NO_SCALE`) are then interpreted
+   *   only once, together with their subroutines; subsequent loads, for
+   *   example at other sizes, only apply the font matrix and scaling.  For
+   *   CFF2 variation fonts, the cache gets flushed if the design
+   *   coordinates change.
+   *
+   *   The default value is~0, which disables the cache; setting the value
+   *   back to~0 stops using already cached glyphs.  Once the limit is
+   *   reached no more glyphs get added; the memory is released when the
+   *   face is destroyed.  The cache is not used for hinted glyph loading,
+   *   with stem darkening, with the 'freetype' @hinting-engine, or with the
+   *   incremental interface.
+   *
+   * @note:
+   *   This property can be used with @FT_Property_Get also.
+   *
+   *   This property can be set via the `FREETYPE_PROPERTIES` environment
+   *   variable (using a decimal number of bytes).
+   *
+   *   Charstrings that use the 'random' operator always get the outline
+   *   of their first interpretation if the cache is active.
+   *
+   * @example:
+   *   ```
+   *     FT_Library  library;
+   *     FT_ULong    size = 4 * 1024 * 1024;
+   *
+   *
+   *     FT_Init_FreeType( &library );
+   *
+   *     FT_Property_Set( library, "cff",
+   *                               "charstring-cache-size", &size );
+   *   ```
+   *
+   * @since:
+   *   2.15
+   */
+
+
   /**************************************************************************
    *
    * @property:
@@ -818,6 +866,160 @@ FT_BEGIN_HEADER
    */
 
 
+  /**************************************************************************
+   *
+   * @property:
+   *   outline-cache-size
+   *
+   * @description:
+   *   The maximum number of bytes per face the TrueType driver may use to
+   *   cache decoded glyph outlines from the 'glyf' table.  Glyphs loaded
+   *   with `FT_LOAD_NO_HINTING` (or `FT_LOAD_NO_SCALE`) are then read and
+   *   decoded only once; subsequent loads, for example at other sizes or
+   *   variation coordinates, only apply variation deltas and scaling.
+   *   Composite glyphs are assembled from their cached components.
+   *
+   *   The default value is~0, which disables the cache.  Once the limit is
+   *   reached no more outlines get added; the memory is released when the
+   *   face is destroyed.  The cache is not used for hinted glyph loading or
+   *   with the incremental interface.
+   *
+   * @note:
+   *   This property can be used with @FT_Property_Get also.
+   *
+   *   This property can be set via the `FREETYPE_PROPERTIES` environment
+   *   variable (using a decimal number of bytes).
+   *
+   * @example:
+   *   ```
+   *     FT_Library  library;
+   *     FT_ULong    size = 4 * 1024 * 1024;
+   *
+   *
+   *     FT_Init_FreeType( &library );
+   *
+   *     FT_Property_Set( library, "truetype",
+   *                               "outline-cache-size", &size );
+   *   ```
+   *
+   * @since:
+   *   2.15
+   */
+
+
+  /**************************************************************************
+   *
+   * @property:
+   *   gvar-cache-size
+   *
+   * @description:
+   *   The maximum number of bytes per face the TrueType driver may use to
+   *   cache the decoded glyph variation data ('gvar' table) of variable
+   *   fonts.  Loading a glyph at new variation coordinates, for example,
+   *   while animating an axis, then only computes the scalars of the
+   *   glyph's tuple variations and sums up the deltas instead of parsing
+   *   the packed point numbers and deltas again.
+   *
+   *   The default value is~0, which disables the cache.  If the limit is
+   *   reached, the data of the least recently used glyphs gets discarded.
+   *   The memory is released when the face is destroyed.
+   *
+   * @note:
+   *   This property can be used with @FT_Property_Get also.
+   *
+   *   This property can be set via the `FREETYPE_PROPERTIES` environment
+   *   variable (using a decimal number of bytes).
+   *
+   * @example:
+   *   ```
+   *     FT_Library  library;
+   *     FT_ULong    size = 1024 * 1024;
+   *
+   *
+   *     FT_Init_FreeType( &library );
+   *
+   *     FT_Property_Set( library, "truetype",
+   *                               "gvar-cache-size", &size );
+   *   ```
+   *
+   * @since:
+   *   2.15
+   */
+
+
+  /**************************************************************************
+   *
+   * @property:
+   *   prep-cache-stats
+   *
+   * @description:
+   *   The TrueType driver keeps the results of a font's CVT program ('prep'
+   *   table) for the most recently used sets of rendering parameters (ppem
+   *   values, scaling, rendering mode, and variation coordinates), sharing
+   *   them between all @FT_Size objects of a face.  Hinting a glyph for a
+   *   new size then only needs a copy of the cached graphics state, CVT,
+   *   and storage area instead of running the CVT program again.
+   *
+   *   This read-only property returns the number of runs of the CVT program
+   *   avoided by the cache (`hits`) and the number of actual runs
+   *   (`misses`) for a given face.
+   *
+   * @note:
+   *   This property can only be used with @FT_Property_Get.
+   *
+   * @example:
+   *   ```
+   *     FT_Library              library;
+   *     FT_Face                 face;
+   *     FT_Prop_PrepCacheStats  stats;
+   *
+   *
+   *     FT_Init_FreeType( &library );
+   *     FT_New_Face( library, "foo.ttf", 0, &face );
+   *
+   *     ... load hinted glyphs in various sizes ...
+   *
+   *     stats.face = face;
+   *
+   *     FT_Property_Get( library, "truetype",
+   *                               "prep-cache-stats", &stats );
+   *   ```
+   *
+   * @since:
+   *   2.15
+   */
+
+
+  /**************************************************************************
+   *
+   * @struct:
+   *   FT_Prop_PrepCacheStats
+   *
+   * @description:
+   *   The data exchange structure for the @prep-cache-stats property.
+   *
+   * @fields:
+   *   face ::
+   *     The face to query; to be set by the caller.
+   *
+   *   hits ::
+   *     The number of CVT program runs avoided by the cache.
+   *
+   *   misses ::
+   *     The number of CVT program runs actually executed.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef struct  FT_Prop_PrepCacheStats_
+  {
+    FT_Face   face;
+    FT_ULong  hits;
+    FT_ULong  misses;
+
+  } FT_Prop_PrepCacheStats;
+
+
   /**************************************************************************
    *
    * @property:
@@ -891,6 +1093,149 @@ FT_BEGIN_HEADER
    */
 
 
+  /**************************************************************************
+   *
+   * @property:
+   *   task_runner
+   *
+   * @description:
+   *   This property of the 'sdf' renderer lets the client application split
+   *   the computation of a single signed distance field into independent
+   *   tasks and execute them concurrently, for example, on a thread pool it
+   *   already owns.  FreeType never creates threads by itself.
+   *
+   *   The value is a pointer to an @FT_Prop_SDF_TaskRunner structure.  If
+   *   its `run_tasks` field is `NULL` (the default) or `num_tasks` is less
+   *   than~2, all tasks are executed sequentially by the calling thread.
+   *
+   * @example:
+   *   The following example code hands over SDF tasks to a hypothetical
+   *   thread pool, where `pool_run` executes `task( task_data, i )` for
+   *   all `i` in the range [0, `num_tasks`[ and returns only after all
+   *   tasks are finished.  Error handling is omitted.
+   *
+   *   ```
+   *     FT_Library              library;
+   *     FT_Prop_SDF_TaskRunner  runner;
+   *
+   *
+   *     FT_Init_FreeType( &library );
+   *
+   *     runner.run_tasks   = pool_run;
+   *     runner.runner_data = pool;
+   *     runner.num_tasks   = 8;
+   *
+   *     FT_Property_Set( library, "sdf", "task_runner", &runner );
+   *   ```
+   *
+   * @note:
+   *   The output is identical to the one generated sequentially,
+   *   independently of the number of tasks and the order in which they are
+   *   executed.
+   *
+   *   Tasks only read the glyph outline and write to disjoint parts of the
+   *   output, so they do not need any synchronization except for the
+   *   completion of `run_tasks`.  Tasks belonging to the same
+   *   @FT_Render_Glyph call must not call back into FreeType.
+   *
+   *   This property is ignored by the 'bsdf' renderer.  It can be used with
+   *   @FT_Property_Get also.
+   *
+   * @since:
+   *   2.15
+   */
+
+
+  /**************************************************************************
+   *
+   * @functype:
+   *   FT_SDF_TaskFunc
+   *
+   * @description:
+   *   A function provided by the 'sdf' renderer that computes a single part
+   *   of a signed distance field.
+   *
+   * @input:
+   *   task_data ::
+   *     The `task_data` argument passed to @FT_SDF_RunTasksFunc.
+   *
+   *   task_index ::
+   *     The index of the task to execute, in the range [0, `num_tasks`[.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef void
+  (*FT_SDF_TaskFunc)( FT_Pointer  task_data,
+                      FT_UInt     task_index );
+
+
+  /**************************************************************************
+   *
+   * @functype:
+   *   FT_SDF_RunTasksFunc
+   *
+   * @description:
+   *   A client function that executes a set of independent tasks, possibly
+   *   concurrently, and returns after all of them have finished.
+   *
+   * @input:
+   *   task ::
+   *     The function to call once for each task.
+   *
+   *   task_data ::
+   *     An opaque pointer to be passed to `task` unchanged.
+   *
+   *   num_tasks ::
+   *     The number of tasks; `task` must be called exactly once for each
+   *     task index in the range [0, `num_tasks`[.
+   *
+   *   runner_data ::
+   *     The `runner_data` field of @FT_Prop_SDF_TaskRunner.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef void
+  (*FT_SDF_RunTasksFunc)( FT_SDF_TaskFunc  task,
+                          FT_Pointer       task_data,
+                          FT_UInt          num_tasks,
+                          FT_Pointer       runner_data );
+
+
+  /**************************************************************************
+   *
+   * @struct:
+   *   FT_Prop_SDF_TaskRunner
+   *
+   * @description:
+   *   The data exchange structure for the @task_runner property.
+   *
+   * @fields:
+   *   run_tasks ::
+   *     The client function that executes tasks.  If set to `NULL`, tasks
+   *     are executed sequentially.
+   *
+   *   runner_data ::
+   *     An opaque pointer passed to `run_tasks`.
+   *
+   *   num_tasks ::
+   *     The maximum number of tasks a single SDF computation is split into,
+   *     usually the number of available threads.  Small glyphs can be split
+   *     into fewer tasks.
+   *
+   * @since:
+   *   2.15
+   */
+  typedef struct  FT_Prop_SDF_TaskRunner_
+  {
+    FT_SDF_RunTasksFunc  run_tasks;
+    FT_Pointer           runner_data;
+    FT_UInt              num_tasks;
+
+  } FT_Prop_SDF_TaskRunner;
+
+
   /**************************************************************************
    *
    * @property:
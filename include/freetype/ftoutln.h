@@ -65,6 +65,7 @@ FT_BEGIN_HEADER
    *   FT_Outline_Get_BBox
    *
    *   FT_Outline_Get_Bitmap
+   *   FT_Outline_Get_Bitmaps
    *   FT_Outline_Render
    *   FT_Outline_Decompose
    *   FT_Outline_Funcs
@@ -460,6 +461,62 @@ FT_BEGIN_HEADER
                          const FT_Bitmap  *abitmap );
 
 
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Outline_Get_Bitmaps
+   *
+   * @description:
+   *   Render a run of outlines within a single bitmap, for example, a glyph
+   *   atlas.  Each outline is placed at its own offset.
+   *
+   * @input:
+   *   library ::
+   *     A handle to a FreeType library object.
+   *
+   *   num_outlines ::
+   *     The number of outlines to render.
+   *
+   *   outlines ::
+   *     An array of `num_outlines` pointers to the source outlines.
+   *
+   *   offsets ::
+   *     An array of `num_outlines` offsets in 26.6 format, added to the
+   *     coordinates of the corresponding outline.  As with
+   *     @FT_Outline_Get_Bitmap, the origin is the lower left corner of the
+   *     bitmap.
+   *
+   * @inout:
+   *   abitmap ::
+   *     A pointer to the target bitmap descriptor.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   This function is equivalent to calling @FT_Outline_Get_Bitmap for
+   *   every outline after translating it by its offset; however, each
+   *   outline is only rendered within the part of `abitmap` covered by its
+   *   control box (clipped to the bitmap), which avoids the setup costs of
+   *   the whole target for every glyph.  This is much faster for large
+   *   targets.  The outlines are left unchanged.
+   *
+   *   As with @FT_Outline_Get_Bitmap, the bitmap is neither created nor
+   *   cleared; pixels not covered by any outline keep their values.
+   *
+   *   Rendering stops at the first outline that fails.
+   *
+   * @since:
+   *   2.15
+   */
+  FT_EXPORT( FT_Error )
+  FT_Outline_Get_Bitmaps( FT_Library        library,
+                          FT_UInt           num_outlines,
+                          FT_Outline*      *outlines,
+                          const FT_Vector*  offsets,
+                          const FT_Bitmap  *abitmap );
+
+
   /**************************************************************************
    *
    * @function:
@@ -186,6 +186,36 @@ FT_BEGIN_HEADER
           FT_MAKE_TAG( 'd', 'a', 'r', 'k' )
 
 
+  /**************************************************************************
+   *
+   * @enum:
+   *   FT_PARAM_TAG_CHARMAP_TABLES
+   *
+   * @description:
+   *   An @FT_Parameter tag to be used with @FT_Face_Properties.  The
+   *   corresponding Boolean argument specifies whether @FT_Get_Char_Index
+   *   should compile a charmap of the face into a two-level lookup table
+   *   when the charmap gets first used.  Afterwards, character codes up to
+   *   0x10FFFF are mapped to glyph indices with two array accesses instead
+   *   of searching the (usually big-endian) charmap data.
+   *
+   *   Building the table takes time linear in the number of mapped
+   *   characters; it needs about 9~KByte plus 512~bytes for every block
+   *   of 256 characters that contains at least one mapped character.  It
+   *   is thus useful for clients that perform many lookups, for example,
+   *   in font fallback code.  The default is off.
+   *
+   *   Faces with more than 65535 glyphs are not supported; lookups then
+   *   work as usual.
+   *
+   * @since:
+   *   2.15
+   *
+   */
+#define FT_PARAM_TAG_CHARMAP_TABLES \
+          FT_MAKE_TAG( 'c', 'm', 'a', 'p' )
+
+
   /**************************************************************************
    *
    * @enum:
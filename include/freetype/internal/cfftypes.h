@@ -289,10 +289,9 @@ FT_BEGIN_HEADER
     FT_Byte*  data;
     FT_UInt   data_size;
 
-    /* small cache for format 3 only */
-    FT_UInt   cache_first;
-    FT_UInt   cache_count;
-    FT_Byte   cache_fd;
+    /* format 3 only: the ranges expanded to one FD index per glyph */
+    FT_Byte*  fds;
+    FT_UInt   num_fds;
 
   } CFF_FDSelectRec, *CFF_FDSelect;
 
@@ -405,6 +404,9 @@ FT_BEGIN_HEADER
     /* since version 2.9 */
     PS_FontExtraRec*  font_extra;
 
+    /* since version 2.15 */
+    void*             charstring_cache;  /* for unhinted glyph loading */
+
   } CFF_FontRec;
 
 
@@ -72,11 +72,11 @@ FT_BEGIN_HEADER
     GX_VarRegion  varRegionList;
 
     /* Cache of per-region scalars for the current normalized coordinates. */
-    /* `regionScalars` holds `regionCount` values, `cachedCoords` the      */
-    /* `axisCount` coordinates they were computed for; both are NULL until */
-    /* first use and recomputed whenever the coordinates change.           */
+    /* `regionScalars` holds `regionCount` values; it is NULL until first  */
+    /* use.  `cachedSerial` is the `coords_serial` value of the blend the  */
+    /* scalars were computed for; they get recomputed if it has changed.   */
     FT_Fixed*  regionScalars;
-    FT_Fixed*  cachedCoords;
+    FT_ULong   cachedSerial;
 
   } GX_ItemVarStoreRec, *GX_ItemVarStore;
 
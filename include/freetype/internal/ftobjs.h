@@ -29,6 +29,7 @@
 #include <freetype/ftrender.h>
 #include <freetype/ftsizes.h>
 #include <freetype/ftlcdfil.h>
+#include <freetype/ftcover.h>
 #include <freetype/internal/ftmemory.h>
 #include <freetype/internal/ftgloadr.h>
 #include <freetype/internal/ftdrv.h>
@@ -145,12 +146,24 @@ FT_BEGIN_HEADER
   /* handle to charmap class structure */
   typedef const struct FT_CMap_ClassRec_*  FT_CMap_Class;
 
-  /* internal charmap object structure */
+  /*
+   * Internal charmap object structure.
+   *
+   * If the face property @FT_PARAM_TAG_CHARMAP_TABLES is set,
+   * `FT_Get_Char_Index` compiles the charmap into a two-level table on
+   * first use: `page_table` maps bits 8-20 of a character code to the
+   * number of a page in `pages`, which holds 256 glyph indices each.
+   * Page~0 is empty.  `no_page_table` is set if the table can't be built.
+   */
   typedef struct  FT_CMapRec_
   {
     FT_CharMapRec  charmap;
     FT_CMap_Class  clazz;
 
+    FT_UShort*     page_table;     /* since 2.15 */
+    FT_UShort*     pages;
+    FT_Bool        no_page_table;
+
   } FT_CMapRec;
 
   /* typecast any pointer to a charmap handle */
@@ -269,6 +282,27 @@ FT_BEGIN_HEADER
   FT_CMap_Done( FT_CMap  cmap );
 
 
+  /* the internal structure of an `FT_Coverage' object; `ranges' holds */
+  /* `num_ranges' pairs of first and last character code, sorted and   */
+  /* neither overlapping nor adjacent                                  */
+  typedef struct  FT_CoverageRec_
+  {
+    FT_Memory   memory;
+    FT_UInt     num_ranges;
+    FT_UInt     max_ranges;
+    FT_UInt32*  ranges;
+
+  } FT_CoverageRec;
+
+
+  /* add a range of character codes to a coverage set; ranges must be */
+  /* added in ascending order (used to compute charmap coverage)      */
+  FT_BASE( FT_Error )
+  FT_Coverage_Add_Range( FT_Coverage  coverage,
+                         FT_UInt32    first,
+                         FT_UInt32    last );
+
+
   /* add LCD padding to CBox */
   FT_BASE( void )
   ft_lcd_padding( FT_BBox*        cbox,
@@ -370,6 +404,26 @@ FT_BEGIN_HEADER
    *     created.  @FT_Reference_Face increments this counter, and
    *     @FT_Done_Face only destroys a face if the counter is~1, otherwise it
    *     simply decrements it.
+   *
+   *   metrics_arrays ::
+   *     The advance values of all glyphs, followed by their side bearings,
+   *     as returned by @FT_Get_Metrics_Arrays.  Allocated on first use.
+   *
+   *   metrics_flags ::
+   *     The load flags used to compute `metrics_arrays`.
+   *
+   *   metrics_scale ::
+   *     The scaling factor used to compute `metrics_arrays`.
+   *
+   *   metrics_valid ::
+   *     Set if `metrics_arrays` is up to date with respect to the variation
+   *     coordinates.
+   *
+   *   metrics_bearings ::
+   *     Set if `metrics_arrays` holds side bearings.
+   *
+   *   charmap_tables ::
+   *     Set if @FT_PARAM_TAG_CHARMAP_TABLES is active for this face.
    */
   typedef struct  FT_Face_InternalRec_
   {
@@ -388,6 +442,14 @@ FT_BEGIN_HEADER
 
     FT_Int  refcount;
 
+    FT_Fixed*  metrics_arrays;
+    FT_Int32   metrics_flags;
+    FT_Fixed   metrics_scale;
+    FT_Bool    metrics_valid;
+    FT_Bool    metrics_bearings;
+
+    FT_Bool    charmap_tables;
+
   } FT_Face_InternalRec;
 
 
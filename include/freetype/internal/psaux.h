@@ -47,6 +47,8 @@ FT_BEGIN_HEADER
     FT_Int    darken_params[8];
     FT_Int32  random_seed;
 
+    FT_ULong  charstring_cache_size;  /* per-face limit in bytes ('cff') */
+
   } PS_DriverRec, *PS_Driver;
 
 
@@ -24,6 +24,7 @@
 
 #include <freetype/internal/ftserv.h>
 #include <freetype/tttables.h>
+#include <freetype/ftcover.h>
 
 
 FT_BEGIN_HEADER
@@ -66,17 +67,47 @@ FT_BEGIN_HEADER
   (*TT_CMap_Info_GetFunc)( FT_CharMap    charmap,
                            TT_CMapInfo  *cmap_info );
 
+  /*
+   * Map `count` character codes to glyph indices (clamped to the number of
+   * glyphs of the face).  If `stop` is set, return after the first
+   * unmapped character code; the return value is the number of character
+   * codes that have been mapped (this is, the index of the unmapped one)
+   * or `count` if all of them have a glyph.
+   */
+  typedef FT_UInt
+  (*TT_CMap_Char_Indices_Func)( FT_CharMap        charmap,
+                                const FT_UInt32*  char_codes,
+                                FT_UInt           count,
+                                FT_UInt*          gindices,
+                                FT_Bool           stop );
+
+  /*
+   * Add the character codes of `charmap` to `coverage`.  Return
+   * `FT_Err_Unimplemented_Feature` if the charmap can't compute its
+   * coverage directly; the caller then has to enumerate it.
+   */
+  typedef FT_Error
+  (*TT_CMap_Coverage_Func)( FT_CharMap   charmap,
+                            FT_Coverage  coverage );
+
 
   FT_DEFINE_SERVICE( TTCMaps )
   {
-    TT_CMap_Info_GetFunc  get_cmap_info;
+    TT_CMap_Info_GetFunc       get_cmap_info;
+    TT_CMap_Char_Indices_Func  char_indices;    /* since 2.15 */
+    TT_CMap_Coverage_Func      get_coverage;    /* since 2.15 */
   };
 
 
-#define FT_DEFINE_SERVICE_TTCMAPSREC( class_, get_cmap_info_ )  \
-  static const FT_Service_TTCMapsRec  class_ =                  \
-  {                                                             \
-    get_cmap_info_                                              \
+#define FT_DEFINE_SERVICE_TTCMAPSREC( class_,          \
+                                      get_cmap_info_,  \
+                                      char_indices_,   \
+                                      get_coverage_ )  \
+  static const FT_Service_TTCMapsRec  class_ =         \
+  {                                                    \
+    get_cmap_info_,                                    \
+    char_indices_,                                     \
+    get_coverage_                                      \
   };
 
   /* */
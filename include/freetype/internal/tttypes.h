@@ -896,6 +896,34 @@ FT_BEGIN_HEADER
 
 #endif /* TT_CONFIG_OPTION_BDF */
 
+
+  /**************************************************************************
+   *
+   * @struct:
+   *   TT_BranchRec
+   *
+   * @description:
+   *   A pre-computed branch of the bytecode interpreter.  For an IF
+   *   instruction, the target is the matching ELSE or EIF instruction that
+   *   gets executed next if the condition is false; for an ELSE
+   *   instruction, it is the matching EIF instruction.
+   *
+   * @fields:
+   *   ip ::
+   *     The offset of the IF or ELSE instruction in the bytecode.
+   *
+   *   target ::
+   *     The offset of the matching ELSE or EIF instruction.  Zero if there
+   *     is none.
+   */
+  typedef struct  TT_BranchRec_
+  {
+    FT_ULong  ip;
+    FT_ULong  target;
+
+  } TT_BranchRec, *TT_Branch;
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
@@ -1408,6 +1436,46 @@ FT_BEGIN_HEADER
    *   svg ::
    *     A pointer to data related to the 'SVG' table.  `NULL` if the table
    *     is not available.
+   *
+   *   font_program_branches ::
+   *     The pre-computed IF and ELSE branches of the font program, sorted
+   *     by offset.
+   *
+   *   font_program_num_branches ::
+   *     The number of elements in `font_program_branches`.
+   *
+   *   cvt_program_branches ::
+   *     The pre-computed IF and ELSE branches of the cvt program, sorted by
+   *     offset.
+   *
+   *   cvt_program_num_branches ::
+   *     The number of elements in `cvt_program_branches`.
+   *
+   *   kern_checked_bits ::
+   *     The kern subtables whose sortedness has already been determined;
+   *     if bit n is set, bit n of `kern_order_bits` is valid.  This is
+   *     done on first use, avoiding a scan of all pairs while opening the
+   *     face.
+   *
+   *   bytecode_loaded ::
+   *     Set if the 'cvt~', 'fpgm', and 'prep' tables have been loaded and
+   *     the branches of the programs have been decoded.  This happens when
+   *     the first size object needs the bytecode interpreter.  Before
+   *     that, only `font_program_size` and `cvt_program_size` are valid.
+   *
+   *   program_image ::
+   *     A pointer to the function and instruction definitions created by
+   *     the font program, shared by all size objects of the face.  `NULL`
+   *     if not yet available.
+   *
+   *   prep_cache ::
+   *     A pointer to the results of the cvt program for recently used
+   *     sizes, shared by all size objects of the face.  `NULL` if not yet
+   *     used.
+   *
+   *   outline_cache ::
+   *     A pointer to decoded simple glyphs for unhinted loading.  `NULL`
+   *     if not yet used.
    */
   typedef struct  TT_FaceRec_
   {
@@ -1604,6 +1672,19 @@ FT_BEGIN_HEADER
     FT_UInt               num_gpos_lookups_kerning;
 #endif
 
+    /* since 2.15 */
+    TT_Branch             font_program_branches;
+    FT_ULong              font_program_num_branches;
+    TT_Branch             cvt_program_branches;
+    FT_ULong              cvt_program_num_branches;
+    FT_Bool               bytecode_loaded;
+
+    FT_UInt32             kern_checked_bits;
+
+    void*                 program_image;
+    void*                 prep_cache;
+    void*                 outline_cache;
+
   } TT_FaceRec;
 
 
@@ -21,6 +21,8 @@
 #include <freetype/ftadvanc.h>
 #include <freetype/internal/ftobjs.h>
 #include <freetype/internal/ftcalc.h>
+#include <freetype/internal/sfnt.h>
+#include <freetype/internal/tttypes.h>
 
 
   static FT_Error
@@ -94,7 +96,9 @@
    /*  - light-hinted load                                         */
    /*  - if a variations font, it must have an `HVAR' or `VVAR'    */
    /*    table (thus the old MM or GX fonts don't qualify; this    */
-   /*    gets checked by the driver-specific functions)            */
+   /*    gets checked by the driver-specific functions); the       */
+   /*    TrueType driver handles horizontal advances of `gvar'     */
+   /*    fonts without `HVAR' table, too                           */
 
 #define LOAD_ADVANCE_FAST_CHECK( face, flags )                      \
           ( flags & ( FT_LOAD_NO_SCALE | FT_LOAD_NO_HINTING )    || \
@@ -191,4 +195,131 @@
   }
 
 
+  /* read the side bearings from the `hmtx' or `vmtx' table; */
+  /* return FALSE if they are not available                  */
+  static FT_Bool
+  ft_face_get_bearings_( FT_Face    face,
+                         FT_Fixed*  bearings,
+                         FT_Int32   flags )
+  {
+    TT_Face       ttface;
+    SFNT_Service  sfnt;
+    FT_Bool       vertical = FT_BOOL( flags & FT_LOAD_VERTICAL_LAYOUT );
+    FT_UInt       nn;
+
+
+    /* the `HVAR' and `VVAR' side bearing mappings are not supported */
+    if ( !FT_IS_SFNT( face )         ||
+         FT_IS_NAMED_INSTANCE( face ) ||
+         FT_IS_VARIATION( face )      )
+      return FALSE;
+
+    ttface = (TT_Face)face;
+    sfnt   = (SFNT_Service)ttface->sfnt;
+
+    if ( vertical ? !ttface->vertical_info : !ttface->horz_metrics_size )
+      return FALSE;
+
+    for ( nn = 0; nn < (FT_UInt)face->num_glyphs; nn++ )
+    {
+      FT_Short   bearing;
+      FT_UShort  advance;
+
+
+      sfnt->get_metrics( ttface, vertical, nn, &bearing, &advance );
+      bearings[nn] = bearing;
+    }
+
+    return TRUE;
+  }
+
+
+  /* documentation is in ftadvanc.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Get_Metrics_Arrays( FT_Face           face,
+                         FT_Int32          flags,
+                         const FT_Fixed*  *padvances,
+                         const FT_Fixed*  *pbearings )
+  {
+    FT_Error          error = FT_Err_Ok;
+    FT_Memory         memory;
+    FT_Face_Internal  internal;
+    FT_Fixed          scale = 0;
+    FT_UInt           num_glyphs;
+
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    if ( !padvances )
+      return FT_THROW( Invalid_Argument );
+
+    *padvances = NULL;
+    if ( pbearings )
+      *pbearings = NULL;
+
+    if ( !( flags & FT_LOAD_NO_SCALE ) )
+    {
+      if ( !face->size )
+        return FT_THROW( Invalid_Size_Handle );
+
+      if ( flags & FT_LOAD_VERTICAL_LAYOUT )
+        scale = face->size->metrics.y_scale;
+      else
+        scale = face->size->metrics.x_scale;
+    }
+
+    memory     = face->memory;
+    internal   = face->internal;
+    num_glyphs = (FT_UInt)face->num_glyphs;
+
+    if ( !num_glyphs )
+      return FT_THROW( Invalid_Glyph_Index );
+
+    if ( !internal->metrics_valid          ||
+         internal->metrics_flags != flags ||
+         internal->metrics_scale != scale )
+    {
+      FT_Fixed*  advances;
+      FT_Fixed*  bearings;
+
+
+      if ( !internal->metrics_arrays                                  &&
+           FT_QNEW_ARRAY( internal->metrics_arrays, 2 * num_glyphs ) )
+        return error;
+
+      advances = internal->metrics_arrays;
+      bearings = advances + num_glyphs;
+
+      internal->metrics_valid = FALSE;
+
+      error = FT_Get_Advances( face, 0, num_glyphs, flags, advances );
+      if ( error )
+        return error;
+
+      internal->metrics_bearings = ft_face_get_bearings_( face,
+                                                          bearings,
+                                                          flags );
+      if ( internal->metrics_bearings )
+      {
+        /* scale the same way as the advances */
+        error = ft_face_scale_advances_( face, bearings, num_glyphs, flags );
+        if ( error )
+          return error;
+      }
+
+      internal->metrics_flags = flags;
+      internal->metrics_scale = scale;
+      internal->metrics_valid = TRUE;
+    }
+
+    *padvances = internal->metrics_arrays;
+    if ( pbearings && internal->metrics_bearings )
+      *pbearings = internal->metrics_arrays + num_glyphs;
+
+    return FT_Err_Ok;
+  }
+
+
 /* END */
@@ -20,6 +20,7 @@
 
 #include "ftadvanc.c"
 #include "ftcolor.c"
+#include "ftcover.c"
 #include "ftdbgmem.c"
 #include "fterrors.c"
 #include "ftfntfmt.c"
@@ -0,0 +1,430 @@
+/****************************************************************************
+ *
+ * ftcover.c
+ *
+ *   FreeType API for charmap coverage sets (body).
+ *
+ * Copyright (C) 2026 by
+ * David Turner, Robert Wilhelm, and Werner Lemberg.
+ *
+ * This file is part of the FreeType project, and may only be used,
+ * modified, and distributed under the terms of the FreeType project
+ * license, LICENSE.TXT.  By continuing to use, modify, or distribute
+ * this file you indicate that you have read the license and
+ * understand and accept it fully.
+ *
+ */
+
+
+#include <freetype/internal/ftdebug.h>
+#include <freetype/internal/ftobjs.h>
+#include <freetype/internal/ftstream.h>
+#include <freetype/internal/services/svttcmap.h>
+#include <freetype/ftcover.h>
+
+
+  /* serialized data: a tag, the number of ranges, and the ranges as */
+  /* pairs of first and last character code, all 32-bit big-endian   */
+#define FT_COVERAGE_TAG  FT_MAKE_TAG( 'F', 'T', 'c', 'v' )
+
+
+  /* documentation is in ftobjs.h */
+
+  FT_BASE_DEF( FT_Error )
+  FT_Coverage_Add_Range( FT_Coverage  coverage,
+                         FT_UInt32    first,
+                         FT_UInt32    last )
+  {
+    FT_Memory   memory = coverage->memory;
+    FT_Error    error;
+    FT_UInt32*  range;
+
+
+    if ( coverage->num_ranges )
+    {
+      range = coverage->ranges + 2 * ( coverage->num_ranges - 1 );
+
+      /* merge overlapping and adjacent ranges */
+      if ( first <= range[1] || first - 1 == range[1] )
+      {
+        if ( last > range[1] )
+          range[1] = last;
+
+        return FT_Err_Ok;
+      }
+    }
+
+    if ( coverage->num_ranges >= coverage->max_ranges )
+    {
+      FT_UInt  new_max = coverage->max_ranges ? 2 * coverage->max_ranges
+                                              : 64;
+
+
+      if ( FT_QRENEW_ARRAY( coverage->ranges,
+                            2 * coverage->max_ranges,
+                            2 * new_max ) )
+        return error;
+
+      coverage->max_ranges = new_max;
+    }
+
+    range    = coverage->ranges + 2 * coverage->num_ranges++;
+    range[0] = first;
+    range[1] = last;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* Compute the coverage by enumeration, in the same way as */
+  /* `FT_Get_First_Char' and `FT_Get_Next_Char'.             */
+  static FT_Error
+  ft_coverage_enumerate( FT_Coverage  coverage,
+                         FT_CMap      cmap )
+  {
+    FT_UInt    num_glyphs = (FT_UInt)cmap->charmap.face->num_glyphs;
+    FT_UInt32  code       = 0;
+    FT_UInt    gindex;
+    FT_Error   error;
+
+
+    gindex = cmap->clazz->char_index( cmap, 0 );
+    if ( gindex && gindex < num_glyphs )
+    {
+      error = FT_Coverage_Add_Range( coverage, 0, 0 );
+      if ( error )
+        return error;
+    }
+
+    for (;;)
+    {
+      FT_UInt32  prev = code;
+
+
+      gindex = cmap->clazz->char_next( cmap, &code );
+
+      /* stop also on broken `char_next' implementations */
+      if ( !gindex || code <= prev )
+        break;
+
+      if ( gindex < num_glyphs )
+      {
+        error = FT_Coverage_Add_Range( coverage, code, code );
+        if ( error )
+          return error;
+      }
+    }
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcover.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Coverage_New( FT_CharMap    charmap,
+                   FT_Coverage  *acoverage )
+  {
+    FT_Error     error;
+    FT_Face      face;
+    FT_Memory    memory;
+    FT_Coverage  coverage = NULL;
+
+
+    if ( !charmap || !charmap->face )
+      return FT_THROW( Invalid_CharMap_Handle );
+
+    if ( !acoverage )
+      return FT_THROW( Invalid_Argument );
+
+    face   = charmap->face;
+    memory = FT_FACE_MEMORY( face );
+
+    if ( FT_NEW( coverage ) )
+      goto Exit;
+
+    coverage->memory = memory;
+
+    error = FT_ERR( Unimplemented_Feature );
+
+    if ( FT_IS_SFNT( face ) )
+    {
+      FT_Service_TTCMaps  service;
+
+
+      FT_FACE_FIND_SERVICE( face, service, TT_CMAP );
+      if ( service && service->get_coverage )
+        error = service->get_coverage( charmap, coverage );
+    }
+
+    if ( FT_ERR_EQ( error, Unimplemented_Feature ) )
+      error = ft_coverage_enumerate( coverage, FT_CMAP( charmap ) );
+
+    if ( error )
+    {
+      FT_Coverage_Done( coverage );
+      coverage = NULL;
+      goto Exit;
+    }
+
+    /* release unused memory */
+    if ( coverage->num_ranges < coverage->max_ranges )
+    {
+      if ( !FT_QRENEW_ARRAY( coverage->ranges,
+                             2 * coverage->max_ranges,
+                             2 * coverage->num_ranges ) )
+        coverage->max_ranges = coverage->num_ranges;
+
+      error = FT_Err_Ok;
+    }
+
+  Exit:
+    *acoverage = coverage;
+
+    return error;
+  }
+
+
+  /* documentation is in ftcover.h */
+
+  FT_EXPORT_DEF( void )
+  FT_Coverage_Done( FT_Coverage  coverage )
+  {
+    FT_Memory  memory;
+
+
+    if ( !coverage )
+      return;
+
+    memory = coverage->memory;
+
+    FT_FREE( coverage->ranges );
+    FT_FREE( coverage );
+  }
+
+
+  /* Return the range containing `code' or NULL. */
+  static const FT_UInt32*
+  ft_coverage_find( FT_Coverage  coverage,
+                    FT_UInt32    code )
+  {
+    FT_UInt  min = 0;
+    FT_UInt  max = coverage->num_ranges;
+
+
+    while ( min < max )
+    {
+      FT_UInt           mid   = ( min + max ) >> 1;
+      const FT_UInt32*  range = coverage->ranges + 2 * mid;
+
+
+      if ( code < range[0] )
+        max = mid;
+      else if ( code > range[1] )
+        min = mid + 1;
+      else
+        return range;
+    }
+
+    return NULL;
+  }
+
+
+  /* documentation is in ftcover.h */
+
+  FT_EXPORT_DEF( FT_Bool )
+  FT_Coverage_Has_Char( FT_Coverage  coverage,
+                        FT_ULong     charcode )
+  {
+    if ( !coverage || charcode > 0xFFFFFFFFUL )
+      return 0;
+
+    return FT_BOOL( ft_coverage_find( coverage, (FT_UInt32)charcode ) );
+  }
+
+
+  /* documentation is in ftcover.h */
+
+  FT_EXPORT_DEF( FT_UInt )
+  FT_Coverage_Check_Chars( FT_Coverage       coverage,
+                           FT_UInt           count,
+                           const FT_UInt32*  charcodes,
+                           FT_Bool*          covered )
+  {
+    /* the range of the last covered character code; initially empty */
+    FT_UInt32  first = 1;
+    FT_UInt32  last  = 0;
+
+    FT_UInt  num_covered = 0;
+    FT_UInt  n;
+
+
+    if ( !coverage || !charcodes )
+      count = 0;
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_UInt32  code = charcodes[n];
+      FT_Bool    is_covered;
+
+
+      /* text usually stays within a script, so try the range */
+      /* of the previous character first                       */
+      if ( code >= first && code <= last )
+        is_covered = 1;
+      else
+      {
+        const FT_UInt32*  range = ft_coverage_find( coverage, code );
+
+
+        is_covered = FT_BOOL( range );
+        if ( range )
+        {
+          first = range[0];
+          last  = range[1];
+        }
+      }
+
+      num_covered += is_covered;
+
+      if ( covered )
+        covered[n] = is_covered;
+    }
+
+    return num_covered;
+  }
+
+
+  static void
+  ft_coverage_put_ulong( FT_Byte*   p,
+                         FT_UInt32  value )
+  {
+    p[0] = (FT_Byte)( value >> 24 );
+    p[1] = (FT_Byte)( value >> 16 );
+    p[2] = (FT_Byte)( value >> 8 );
+    p[3] = (FT_Byte)( value );
+  }
+
+
+  /* documentation is in ftcover.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Coverage_Save( FT_Coverage  coverage,
+                    FT_Byte*     buffer,
+                    FT_ULong    *alength )
+  {
+    FT_ULong  length;
+    FT_UInt   n;
+
+
+    if ( !coverage || !alength )
+      return FT_THROW( Invalid_Argument );
+
+    length = 8 + 8 * (FT_ULong)coverage->num_ranges;
+
+    if ( !buffer )
+    {
+      *alength = length;
+      return FT_Err_Ok;
+    }
+
+    if ( *alength < length )
+    {
+      *alength = length;
+      return FT_THROW( Invalid_Argument );
+    }
+
+    *alength = length;
+
+    ft_coverage_put_ulong( buffer, FT_COVERAGE_TAG );
+    ft_coverage_put_ulong( buffer + 4, coverage->num_ranges );
+    buffer += 8;
+
+    for ( n = 0; n < 2 * coverage->num_ranges; n++, buffer += 4 )
+      ft_coverage_put_ulong( buffer, coverage->ranges[n] );
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcover.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Coverage_Load( FT_Library      library,
+                    const FT_Byte*  buffer,
+                    FT_ULong        length,
+                    FT_Coverage    *acoverage )
+  {
+    FT_Error     error;
+    FT_Memory    memory;
+    FT_Coverage  coverage = NULL;
+    FT_UInt32    num_ranges;
+    FT_UInt32    n;
+
+
+    if ( !library )
+      return FT_THROW( Invalid_Library_Handle );
+
+    if ( !buffer || !acoverage )
+      return FT_THROW( Invalid_Argument );
+
+    memory = library->memory;
+
+    if ( length < 8 || FT_PEEK_ULONG( buffer ) != FT_COVERAGE_TAG )
+    {
+      error = FT_THROW( Invalid_File_Format );
+      goto Exit;
+    }
+
+    num_ranges = FT_PEEK_ULONG( buffer + 4 );
+    if ( ( length - 8 ) / 8 < num_ranges )
+    {
+      error = FT_THROW( Invalid_File_Format );
+      goto Exit;
+    }
+
+    if ( FT_NEW( coverage ) )
+      goto Exit;
+
+    coverage->memory = memory;
+
+    if ( FT_QNEW_ARRAY( coverage->ranges, 2 * num_ranges ) )
+      goto Fail;
+
+    coverage->num_ranges = num_ranges;
+    coverage->max_ranges = num_ranges;
+
+    buffer += 8;
+
+    for ( n = 0; n < num_ranges; n++, buffer += 8 )
+    {
+      FT_UInt32  first = FT_PEEK_ULONG( buffer );
+      FT_UInt32  last  = FT_PEEK_ULONG( buffer + 4 );
+
+
+      /* ranges must be sorted and must not overlap */
+      if ( first > last                                    ||
+           ( n > 0 && first <= coverage->ranges[2 * n - 1] ) )
+      {
+        error = FT_THROW( Invalid_File_Format );
+        goto Fail;
+      }
+
+      coverage->ranges[2 * n]     = first;
+      coverage->ranges[2 * n + 1] = last;
+    }
+
+    goto Exit;
+
+  Fail:
+    FT_Coverage_Done( coverage );
+    coverage = NULL;
+
+  Exit:
+    *acoverage = coverage;
+
+    return error;
+  }
+
+
+/* END */
@@ -202,6 +202,10 @@
       face->autohint.data = NULL;
     }
 
+    /* enforce recomputation of `FT_Get_Metrics_Arrays' data */
+    if ( !error )
+      face->internal->metrics_valid = FALSE;
+
     return error;
   }
 
@@ -245,6 +249,10 @@
       face->autohint.data = NULL;
     }
 
+    /* enforce recomputation of `FT_Get_Metrics_Arrays' data */
+    if ( !error )
+      face->internal->metrics_valid = FALSE;
+
     return error;
   }
 
@@ -352,6 +360,10 @@
       face->autohint.data = NULL;
     }
 
+    /* enforce recomputation of `FT_Get_Metrics_Arrays' data */
+    if ( !error )
+      face->internal->metrics_valid = FALSE;
+
     return error;
   }
 
@@ -452,6 +464,10 @@
       face->autohint.data = NULL;
     }
 
+    /* enforce recomputation of `FT_Get_Metrics_Arrays' data */
+    if ( !error )
+      face->internal->metrics_valid = FALSE;
+
     return error;
   }
 
@@ -533,6 +549,10 @@
       face->autohint.data = NULL;
     }
 
+    /* enforce recomputation of `FT_Get_Metrics_Arrays' data */
+    if ( !error )
+      face->internal->metrics_valid = FALSE;
+
     return error;
   }
 
@@ -684,6 +704,10 @@
       face->autohint.data = NULL;
     }
 
+    /* enforce recomputation of `FT_Get_Metrics_Arrays' data */
+    if ( !error )
+      face->internal->metrics_valid = FALSE;
+
     return error;
   }
 
@@ -1350,6 +1350,7 @@
     /* get rid of it */
     if ( face->internal )
     {
+      FT_FREE( face->internal->metrics_arrays );
       FT_FREE( face->internal );
     }
     FT_FREE( face );
@@ -3804,6 +3805,18 @@
   }
 
 
+  static void
+  ft_cmap_done_page_table( FT_CMap  cmap )
+  {
+    FT_Memory  memory = FT_FACE_MEMORY( cmap->charmap.face );
+
+
+    FT_FREE( cmap->page_table );
+    FT_FREE( cmap->pages );
+    cmap->no_page_table = FALSE;
+  }
+
+
   static void
   ft_cmap_done_internal( FT_CMap  cmap )
   {
@@ -3815,6 +3828,8 @@
     if ( clazz->done )
       clazz->done( cmap );
 
+    ft_cmap_done_page_table( cmap );
+
     FT_FREE( cmap );
   }
 
@@ -3917,6 +3932,104 @@
   }
 
 
+#define FT_CMAP_NUM_PAGES  ( 0x110000UL >> 8 )
+
+  /* Compile a charmap into the two-level table described in `ftobjs.h`. */
+  /* We enumerate the mapped character codes with the `char_next`        */
+  /* method but take the glyph indices from `char_index` so that the     */
+  /* table gives exactly the same results as the charmap itself.         */
+  static void
+  ft_cmap_build_page_table( FT_CMap  cmap )
+  {
+    FT_Face        face   = cmap->charmap.face;
+    FT_CMap_Class  clazz  = cmap->clazz;
+    FT_Memory      memory = FT_FACE_MEMORY( face );
+    FT_Error       error;
+
+    FT_UShort*  page_table = NULL;
+    FT_UShort*  pages      = NULL;
+    FT_ULong    num_pages  = 1;   /* page 0 is empty */
+    FT_ULong    max_pages  = 0;
+    FT_UInt32   charcode   = 0;
+    FT_UInt     gindex;
+
+
+    /* in case of failure, don't try again */
+    cmap->no_page_table = TRUE;
+
+    /* the table holds 16-bit glyph indices */
+    if ( face->num_glyphs > 0xFFFFL )
+      return;
+
+    if ( FT_NEW_ARRAY( page_table, FT_CMAP_NUM_PAGES ) )
+      goto Fail;
+
+    gindex = clazz->char_index( cmap, 0 );
+
+    while ( charcode < 0x110000UL )
+    {
+      FT_UInt32  next = charcode;
+
+
+      if ( gindex && gindex < (FT_UInt)face->num_glyphs )
+      {
+        FT_ULong  page = page_table[charcode >> 8];
+
+
+        if ( !page )
+        {
+          if ( num_pages >= max_pages )
+          {
+            FT_ULong  new_max = max_pages ? 2 * max_pages : 16;
+
+
+            if ( new_max > FT_CMAP_NUM_PAGES + 1 )
+              new_max = FT_CMAP_NUM_PAGES + 1;
+
+            if ( FT_RENEW_ARRAY( pages, max_pages * 256, new_max * 256 ) )
+              goto Fail;
+
+            max_pages = new_max;
+          }
+
+          page                      = num_pages++;
+          page_table[charcode >> 8] = (FT_UShort)page;
+        }
+
+        pages[( page << 8 ) | ( charcode & 0xFF )] = (FT_UShort)gindex;
+      }
+
+      if ( !clazz->char_next( cmap, &next ) || next <= charcode )
+        break;
+
+      charcode = next;
+      gindex   = clazz->char_index( cmap, charcode );
+    }
+
+    if ( !pages )
+    {
+      /* no mapped character code at all; we only need page 0 */
+      if ( FT_NEW_ARRAY( pages, 256 ) )
+        goto Fail;
+    }
+    else if ( FT_QRENEW_ARRAY( pages, max_pages * 256, num_pages * 256 ) )
+      goto Fail;
+
+    FT_TRACE4(( "ft_cmap_build_page_table: %lu pages for charmap %d\n",
+                num_pages, FT_Get_Charmap_Index( &cmap->charmap ) ));
+
+    cmap->page_table    = page_table;
+    cmap->pages         = pages;
+    cmap->no_page_table = FALSE;
+
+    return;
+
+  Fail:
+    FT_FREE( page_table );
+    FT_FREE( pages );
+  }
+
+
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_UInt )
@@ -3937,15 +4050,189 @@
         FT_TRACE1(( " 0x%lx is truncated\n", charcode ));
       }
 
-      result = cmap->clazz->char_index( cmap, (FT_UInt32)charcode );
-      if ( result >= (FT_UInt)face->num_glyphs )
-        result = 0;
+      if ( face->internal->charmap_tables &&
+           !cmap->page_table              &&
+           !cmap->no_page_table           )
+        ft_cmap_build_page_table( cmap );
+
+      if ( cmap->page_table && charcode < 0x110000UL )
+        result = cmap->pages[( (FT_ULong)cmap->page_table[charcode >> 8]
+                                 << 8 ) | ( charcode & 0xFF )];
+      else
+      {
+        result = cmap->clazz->char_index( cmap, (FT_UInt32)charcode );
+        if ( result >= (FT_UInt)face->num_glyphs )
+          result = 0;
+      }
     }
 
     return result;
   }
 
 
+  /* Unicode characters with property `Variation_Selector'. */
+#define FT_IS_VARIATION_SELECTOR( c )                       \
+          ( ( (c) >= 0x180BUL  && (c) <= 0x180FUL  &&         \
+              (c) != 0x180EUL                         ) ||    \
+            ( (c) >= 0xFE00UL  && (c) <= 0xFE0FUL     ) ||    \
+            ( (c) >= 0xE0100UL && (c) <= 0xE01EFUL    )    )
+
+
+  /* Map a run of character codes with `cmap'; this returns the number */
+  /* of processed codes, which is less than `count' only if `stop' is  */
+  /* set and an unmapped code was found.                               */
+  static FT_UInt
+  ft_cmap_char_indices( FT_CMap             cmap,
+                        FT_Service_TTCMaps  service,
+                        const FT_UInt32*    char_codes,
+                        FT_UInt             count,
+                        FT_UInt*            gindices,
+                        FT_Bool             stop )
+  {
+    FT_Face  face = cmap->charmap.face;
+    FT_UInt  n;
+
+
+    if ( face->internal->charmap_tables &&
+         !cmap->page_table              &&
+         !cmap->no_page_table           )
+      ft_cmap_build_page_table( cmap );
+
+    if ( !cmap->page_table && service && service->char_indices )
+      return service->char_indices( (FT_CharMap)cmap, char_codes,
+                                    count, gindices, stop );
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_UInt32  char_code = char_codes[n];
+      FT_UInt    gindex;
+
+
+      if ( cmap->page_table && char_code < 0x110000UL )
+        gindex = cmap->pages[( (FT_ULong)cmap->page_table[char_code >> 8]
+                                 << 8 ) | ( char_code & 0xFF )];
+      else
+      {
+        gindex = cmap->clazz->char_index( cmap, char_code );
+        if ( gindex >= (FT_UInt)face->num_glyphs )
+          gindex = 0;
+      }
+
+      gindices[n] = gindex;
+
+      if ( stop && !gindex )
+        return n;
+    }
+
+    return count;
+  }
+
+
+  /* documentation is in freetype.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Get_Char_Indices( FT_Face           face,
+                       FT_UInt           count,
+                       const FT_UInt32*  charcodes,
+                       FT_UInt*          gindices,
+                       FT_UInt          *afirst_unmapped )
+  {
+    FT_Error            error   = FT_Err_Ok;
+    FT_Service_TTCMaps  service = NULL;
+    FT_CMap             ucmap;
+    FT_CMap             vcmap   = NULL;
+    FT_Bool             stop    = FT_BOOL( afirst_unmapped != NULL );
+    FT_UInt             n, end, mapped;
+
+
+    if ( afirst_unmapped )
+      *afirst_unmapped = 0;
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    if ( !face->charmap )
+      return FT_THROW( Invalid_CharMap_Handle );
+
+    if ( count && ( !charcodes || !gindices ) )
+      return FT_THROW( Invalid_Argument );
+
+    ucmap = FT_CMAP( face->charmap );
+
+    if ( FT_IS_SFNT( face ) )
+    {
+      FT_FACE_FIND_SERVICE( face, service, TT_CMAP );
+
+      if ( face->charmap->encoding == FT_ENCODING_UNICODE )
+      {
+        FT_CharMap  charmap = find_variant_selector_charmap( face );
+
+
+        if ( charmap )
+          vcmap = FT_CMAP( charmap );
+      }
+    }
+
+    /* Without a variation selector cmap, the whole array is a single */
+    /* run.  Otherwise we map the runs between variation selectors,   */
+    /* each selector modifying the last character of the run before.  */
+    for ( n = 0; n < count; n = end )
+    {
+      end = n;
+      if ( vcmap )
+      {
+        while ( end < count && !FT_IS_VARIATION_SELECTOR( charcodes[end] ) )
+          end++;
+      }
+      else
+        end = count;
+
+      mapped = n + ft_cmap_char_indices( ucmap, service,
+                                         charcodes + n, end - n,
+                                         gindices + n, stop );
+      if ( mapped < end )
+      {
+        /* a variation sequence might still have a glyph */
+        if ( mapped + 1 < end || end == count )
+          goto Stop;
+
+        gindices[mapped] = vcmap->clazz->char_var_index( vcmap, ucmap,
+                                                         charcodes[mapped],
+                                                         charcodes[end] );
+        if ( !gindices[mapped] )
+          goto Stop;
+      }
+
+      /* apply the variation selectors following the run */
+      for ( ; end < count && FT_IS_VARIATION_SELECTOR( charcodes[end] );
+              end++ )
+      {
+        if ( end > n && !FT_IS_VARIATION_SELECTOR( charcodes[end - 1] ) )
+        {
+          FT_UInt  gindex;
+
+
+          gindex = vcmap->clazz->char_var_index( vcmap, ucmap,
+                                                 charcodes[end - 1],
+                                                 charcodes[end] );
+          if ( gindex )
+            gindices[end - 1] = gindex;
+        }
+
+        gindices[end] = 0;
+      }
+    }
+
+    mapped = count;
+
+  Stop:
+    if ( afirst_unmapped )
+      *afirst_unmapped = mapped;
+
+    return error;
+  }
+
+
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_ULong )
@@ -4042,6 +4329,22 @@
         error = FT_THROW( Unimplemented_Feature );
         goto Exit;
       }
+      else if ( properties->tag == FT_PARAM_TAG_CHARMAP_TABLES )
+      {
+        FT_Bool  charmap_tables = FALSE;
+        FT_Int   n;
+
+
+        if ( properties->data )
+          charmap_tables = *( (FT_Bool*)properties->data );
+
+        face->internal->charmap_tables = charmap_tables;
+
+        /* tables get built on demand; remove them if switched off */
+        if ( !charmap_tables )
+          for ( n = 0; n < face->num_charmaps; n++ )
+            ft_cmap_done_page_table( FT_CMAP( face->charmaps[n] ) );
+      }
       else if ( properties->tag == FT_PARAM_TAG_RANDOM_SEED )
       {
         if ( properties->data )
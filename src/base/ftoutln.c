@@ -690,6 +690,108 @@
   }
 
 
+  /* documentation is in ftoutln.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Outline_Get_Bitmaps( FT_Library        library,
+                          FT_UInt           num_outlines,
+                          FT_Outline*      *outlines,
+                          const FT_Vector*  offsets,
+                          const FT_Bitmap  *abitmap )
+  {
+    FT_Error          error = FT_Err_Ok;
+    FT_Raster_Params  params;
+    FT_Bitmap         target;
+    FT_UInt           n;
+
+
+    if ( !library )
+      return FT_THROW( Invalid_Library_Handle );
+
+    if ( !abitmap || ( num_outlines && ( !outlines || !offsets ) ) )
+      return FT_THROW( Invalid_Argument );
+
+    target        = *abitmap;
+    params.target = &target;
+    params.flags  = 0;
+
+    if ( abitmap->pixel_mode == FT_PIXEL_MODE_GRAY  ||
+         abitmap->pixel_mode == FT_PIXEL_MODE_LCD   ||
+         abitmap->pixel_mode == FT_PIXEL_MODE_LCD_V )
+      params.flags |= FT_RASTER_FLAG_AA;
+
+    for ( n = 0; n < num_outlines; n++ )
+    {
+      FT_Outline*  outline = outlines[n];
+      FT_BBox      cbox;
+      FT_Pos       xMin, yMin, xMax, yMax;
+      FT_Pos       dx, dy;
+      FT_Int       pitch = abitmap->pitch;
+
+
+      if ( !outline )
+      {
+        error = FT_THROW( Invalid_Outline );
+        break;
+      }
+
+      FT_Outline_Get_CBox( outline, &cbox );
+
+      /* checked again by `FT_Outline_Render' after translation */
+      if ( cbox.xMin < -0x1000000L || cbox.yMin < -0x1000000L ||
+           cbox.xMax >  0x1000000L || cbox.yMax >  0x1000000L )
+      {
+        error = FT_THROW( Invalid_Outline );
+        break;
+      }
+
+      /* the covered pixels, clipped to the bitmap; we add a margin */
+      /* of one pixel so that the drop-out control of the monochrome */
+      /* rasterizer sees the same clipping as for the whole bitmap   */
+      xMin = FT_MAX( 0, ( ( cbox.xMin + offsets[n].x ) >> 6 ) - 1 );
+      yMin = FT_MAX( 0, ( ( cbox.yMin + offsets[n].y ) >> 6 ) - 1 );
+      xMax = FT_MIN( (FT_Pos)abitmap->width,
+                     ( ( cbox.xMax + offsets[n].x + 63 ) >> 6 ) + 1 );
+      yMax = FT_MIN( (FT_Pos)abitmap->rows,
+                     ( ( cbox.yMax + offsets[n].y + 63 ) >> 6 ) + 1 );
+
+      /* monochrome bitmaps must start at a byte boundary */
+      if ( abitmap->pixel_mode == FT_PIXEL_MODE_MONO )
+        xMin &= ~7;
+
+      if ( xMin >= xMax || yMin >= yMax )
+        continue;
+
+      /* the target's first row is the top one with positive pitch */
+      target.width  = (unsigned int)( xMax - xMin );
+      target.rows   = (unsigned int)( yMax - yMin );
+      target.buffer = abitmap->buffer;
+
+      if ( pitch > 0 )
+        target.buffer += ( (FT_Pos)abitmap->rows - yMax ) * pitch;
+      else
+        target.buffer -= yMin * pitch;
+
+      if ( abitmap->pixel_mode == FT_PIXEL_MODE_MONO )
+        target.buffer += xMin >> 3;
+      else
+        target.buffer += xMin;
+
+      dx = offsets[n].x - xMin * 64;
+      dy = offsets[n].y - yMin * 64;
+
+      FT_Outline_Translate( outline, dx, dy );
+      error = FT_Outline_Render( library, outline, &params );
+      FT_Outline_Translate( outline, -dx, -dy );
+
+      if ( error )
+        break;
+    }
+
+    return error;
+  }
+
+
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( void )
@@ -220,6 +220,33 @@
       return error;
     }
 
+    else if ( !ft_strcmp( property_name, "charstring-cache-size" ) &&
+              !ft_strcmp( module->clazz->module_name, "cff" )      )
+    {
+#ifdef FT_CONFIG_OPTION_ENVIRONMENT_PROPERTIES
+      if ( value_is_string )
+      {
+        const char*  s = (const char*)value;
+        long         n = ft_strtol( s, NULL, 10 );
+
+
+        if ( n < 0 )
+          return FT_THROW( Invalid_Argument );
+
+        driver->charstring_cache_size = (FT_ULong)n;
+      }
+      else
+#endif
+      {
+        FT_ULong*  size = (FT_ULong*)value;
+
+
+        driver->charstring_cache_size = *size;
+      }
+
+      return error;
+    }
+
     FT_TRACE2(( "ps_property_set: missing property `%s'\n",
                 property_name ));
     return FT_THROW( Missing_Property );
@@ -275,6 +302,17 @@
       return error;
     }
 
+    else if ( !ft_strcmp( property_name, "charstring-cache-size" ) &&
+              !ft_strcmp( module->clazz->module_name, "cff" )      )
+    {
+      FT_ULong*  val = (FT_ULong*)value;
+
+
+      *val = driver->charstring_cache_size;
+
+      return error;
+    }
+
     FT_TRACE2(( "ps_property_get: missing property `%s'\n",
                 property_name ));
     return FT_THROW( Missing_Property );
@@ -39,6 +39,7 @@ BASE_COMPILE := $(CC) $(ANSIFLAGS)                             \
 BASE_SRC := $(BASE_DIR)/ftadvanc.c \
             $(BASE_DIR)/ftcalc.c   \
             $(BASE_DIR)/ftcolor.c  \
+            $(BASE_DIR)/ftcover.c  \
             $(BASE_DIR)/ftdbgmem.c \
             $(BASE_DIR)/fterrors.c \
             $(BASE_DIR)/ftfntfmt.c \
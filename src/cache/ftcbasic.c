@@ -18,6 +18,7 @@
 
 #include <freetype/internal/ftobjs.h>
 #include <freetype/internal/ftdebug.h>
+#include <freetype/internal/ftstream.h>
 #include <freetype/ftcache.h>
 #include "ftcglyph.h"
 #include "ftcimage.h"
@@ -104,8 +105,8 @@
     FT_UInt          result = 0;
 
 
-    error = FTC_Manager_LookupFace( manager, family->attrs.scaler.face_id,
-                                    &face );
+    error = ftc_manager_lookup_face( manager, family->attrs.scaler.face_id,
+                                     &face );
 
     if ( error || !face )
       return result;
@@ -138,7 +139,7 @@
     FT_Size          size;
 
 
-    error = FTC_Manager_LookupSize( manager, &family->attrs.scaler, &size );
+    error = ftc_manager_lookup_size( manager, &family->attrs.scaler, &size );
     if ( !error )
     {
       FT_Face  face = size->face;
@@ -169,9 +170,9 @@
 
 
     /* we will now load the glyph image */
-    error = FTC_Manager_LookupSize( cache->manager,
-                                    scaler,
-                                    &size );
+    error = ftc_manager_lookup_size( cache->manager,
+                                     scaler,
+                                     &size );
     if ( !error )
     {
       face = size->face;
@@ -270,6 +271,160 @@
   };
 
 
+  /*
+   * Look up `num_glyphs' glyphs of the same family.  The family is
+   * resolved only once.  Every returned node is acquired (i.e., its
+   * reference count is incremented) so that it can't be flushed while
+   * the remaining glyphs are loaded; in case of error, all nodes are
+   * released again.  Since every element holds its own reference, a
+   * node can't appear more than 0x7FFF times in a run (minus the
+   * references held elsewhere).  The manager must be locked by the
+   * caller.
+   */
+  static FT_Error
+  ftc_basic_lookup_glyphs( FTC_GCache            cache,
+                           FTC_BasicQuery        query,
+                           FTC_Node_CompareFunc  compare,
+                           FT_UInt               items_per_node,
+                           FT_UInt               num_glyphs,
+                           const FT_UInt        *gindices,
+                           FTC_Node             *nodes )
+  {
+    FT_Error     error;
+    FT_Offset    family_hash;
+    FTC_MruNode  mrunode;
+    FTC_Family   family;
+    FT_UInt      nn;
+
+
+    family_hash = FTC_BASIC_ATTR_HASH( &query->attrs );
+
+    query->gquery.gindex = gindices[0];
+
+    FTC_MRULIST_LOOKUP( &cache->families, query, mrunode, error );
+    if ( error )
+      return error;
+
+    family               = FTC_FAMILY( mrunode );
+    query->gquery.family = family;
+
+    /* keep the family alive during the whole run */
+    family->num_nodes++;
+
+    for ( nn = 0; nn < num_glyphs; nn++ )
+    {
+      FT_UInt    gindex = gindices[nn];
+      FT_Offset  hash   = family_hash + gindex / items_per_node;
+      FTC_Node   node   = NULL;
+
+
+      query->gquery.gindex = gindex;
+
+      /* the macro argument must be named `hash' */
+#ifdef FTC_INLINE
+      FTC_CACHE_LOOKUP_CMP( cache, compare, hash, query, node, error );
+#else
+      FT_UNUSED( compare );
+
+      error = FTC_Cache_Lookup( FTC_CACHE( cache ), hash, query, &node );
+#endif
+      if ( error )
+        break;
+
+      /* `ref_count' is a short; refuse runs that would overflow it */
+      if ( node->ref_count >= 0x7FFF )
+      {
+        error = FT_THROW( Invalid_Argument );
+        break;
+      }
+
+      node->ref_count++;
+      nodes[nn] = node;
+    }
+
+    if ( error )
+    {
+      FT_UInt  count = nn;
+
+
+      for ( nn = 0; nn < count; nn++ )
+        nodes[nn]->ref_count--;
+
+      for ( nn = 0; nn < num_glyphs; nn++ )
+        nodes[nn] = NULL;
+    }
+
+    if ( --family->num_nodes == 0 )
+      FTC_FAMILY_FREE( family, cache );
+
+    return error;
+  }
+
+
+  /* Set up the query of a batch lookup, pick the array to hold the */
+  /* nodes, and lock the manager.                                   */
+  static FT_Error
+  ftc_basic_lookup_glyphs_begin( FTC_Cache        cache,
+                                 FTC_Scaler       scaler,
+                                 FT_ULong         load_flags,
+                                 FT_UInt          num_glyphs,
+                                 FTC_BasicQuery   query,
+                                 FTC_Node        *anodes,
+                                 FTC_Node*       *pnodes )
+  {
+    FT_Error   error  = FT_Err_Ok;
+    FT_Memory  memory = cache->memory;
+
+
+#if FT_ULONG_MAX > 0xFFFFFFFFUL
+    if ( load_flags > 0xFFFFFFFFUL )
+      FT_TRACE1(( "ftc_basic_lookup_glyphs_begin:"
+                  " higher bits in load_flags 0x%lx are dropped\n",
+                  load_flags & ~0xFFFFFFFFUL ));
+#endif
+
+    query->attrs.scaler     = scaler[0];
+    query->attrs.load_flags = (FT_Int32)load_flags;
+
+    /* without an output array for the nodes we need a temporary one */
+    /* to hold them while the run is being loaded                    */
+    *pnodes = anodes;
+    if ( !anodes && FT_QNEW_ARRAY( *pnodes, num_glyphs ) )
+      return error;
+
+    FTC_MANAGER_LOCK( cache->manager );
+
+    return error;
+  }
+
+
+  static void
+  ftc_basic_lookup_glyphs_end( FTC_Cache   cache,
+                               FT_UInt     num_glyphs,
+                               FTC_Node   *anodes,
+                               FTC_Node   *nodes,
+                               FT_Error    error )
+  {
+    FT_Memory  memory = cache->memory;
+
+
+    /* release the nodes if the client doesn't want them */
+    if ( !error && !anodes )
+    {
+      FT_UInt  nn;
+
+
+      for ( nn = 0; nn < num_glyphs; nn++ )
+        nodes[nn]->ref_count--;
+    }
+
+    FTC_MANAGER_UNLOCK( cache->manager );
+
+    if ( !anodes )
+      FT_FREE( nodes );
+  }
+
+
   /* documentation is in ftcache.h */
 
   FT_EXPORT_DEF( FT_Error )
@@ -297,7 +452,7 @@
 
 
     /* other argument checks delayed to `FTC_Cache_Lookup' */
-    if ( !aglyph )
+    if ( !cache || !aglyph )
       return FT_THROW( Invalid_Argument );
 
     *aglyph = NULL;
@@ -315,6 +470,8 @@
 
     hash = FTC_BASIC_ATTR_HASH( &query.attrs ) + gindex;
 
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+
 #ifdef FTC_INLINE  /* inlining is about 50% faster! */
     FTC_GCACHE_LOOKUP_CMP( cache,
                            ftc_basic_family_compare,
@@ -340,6 +497,8 @@
       }
     }
 
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
     return error;
   }
 
@@ -361,7 +520,7 @@
 
 
     /* other argument checks delayed to `FTC_Cache_Lookup' */
-    if ( !aglyph || !scaler )
+    if ( !cache || !aglyph || !scaler )
       return FT_THROW( Invalid_Argument );
 
     *aglyph = NULL;
@@ -386,6 +545,8 @@
 
     hash = FTC_BASIC_ATTR_HASH( &query.attrs ) + gindex;
 
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+
     FTC_GCACHE_LOOKUP_CMP( cache,
                            ftc_basic_family_compare,
                            ftc_gnode_compare,
@@ -404,10 +565,90 @@
       }
     }
 
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
+    return error;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_ImageCache_LookupGlyphs( FTC_ImageCache  cache,
+                               FTC_Scaler      scaler,
+                               FT_ULong        load_flags,
+                               FT_UInt         num_glyphs,
+                               const FT_UInt  *gindices,
+                               FT_Glyph       *aglyphs,
+                               FTC_Node       *anodes )
+  {
+    FT_Error           error;
+    FTC_BasicQueryRec  query;
+    FTC_Node*          nodes;
+    FT_UInt            nn;
+
+
+    if ( !cache || !scaler || !aglyphs || ( num_glyphs && !gindices ) )
+      return FT_THROW( Invalid_Argument );
+
+    if ( !num_glyphs )
+      return FT_Err_Ok;
+
+    error = ftc_basic_lookup_glyphs_begin( FTC_CACHE( cache ),
+                                           scaler, load_flags, num_glyphs,
+                                           &query, anodes, &nodes );
+    if ( error )
+      return error;
+
+    error = ftc_basic_lookup_glyphs( FTC_GCACHE( cache ), &query,
+                                     ftc_gnode_compare, 1,
+                                     num_glyphs, gindices, nodes );
+
+    for ( nn = 0; nn < num_glyphs; nn++ )
+      aglyphs[nn] = nodes[nn] ? FTC_INODE( nodes[nn] )->glyph : NULL;
+
+    ftc_basic_lookup_glyphs_end( FTC_CACHE( cache ), num_glyphs,
+                                 anodes, nodes, error );
+
     return error;
   }
 
 
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_ImageCache_SetMaxBytes( FTC_ImageCache  cache,
+                              FT_ULong        max_bytes )
+  {
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    FTC_Cache_SetMaxWeight( FTC_CACHE( cache ), max_bytes );
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_ImageCache_GetStats( FTC_ImageCache  cache,
+                           FTC_Stats       astats )
+  {
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    if ( !astats )
+      return FT_THROW( Invalid_Argument );
+
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+    FTC_Cache_GetStats( FTC_CACHE( cache ), astats );
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
+    return FT_Err_Ok;
+  }
+
+
   /*
    *
    * basic small bitmap cache
@@ -475,7 +716,7 @@
 
 
     /* other argument checks delayed to `FTC_Cache_Lookup' */
-    if ( !ansbit )
+    if ( !cache || !ansbit )
       return FT_THROW( Invalid_Argument );
 
     *ansbit = NULL;
@@ -495,6 +736,8 @@
     hash = FTC_BASIC_ATTR_HASH( &query.attrs ) +
            gindex / FTC_SBIT_ITEMS_PER_NODE;
 
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+
 #ifdef FTC_INLINE  /* inlining is about 50% faster! */
     FTC_GCACHE_LOOKUP_CMP( cache,
                            ftc_basic_family_compare,
@@ -523,6 +766,8 @@
     }
 
   Exit:
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
     return error;
   }
 
@@ -544,7 +789,7 @@
 
 
     /* other argument checks delayed to `FTC_Cache_Lookup' */
-    if ( !ansbit || !scaler )
+    if ( !cache || !ansbit || !scaler )
       return FT_THROW( Invalid_Argument );
 
     *ansbit = NULL;
@@ -571,6 +816,8 @@
     hash = FTC_BASIC_ATTR_HASH( &query.attrs ) +
              gindex / FTC_SBIT_ITEMS_PER_NODE;
 
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+
     FTC_GCACHE_LOOKUP_CMP( cache,
                            ftc_basic_family_compare,
                            ftc_snode_compare,
@@ -591,6 +838,403 @@
     }
 
   Exit:
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
+    return error;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_SBitCache_LookupGlyphs( FTC_SBitCache   cache,
+                              FTC_Scaler      scaler,
+                              FT_ULong        load_flags,
+                              FT_UInt         num_glyphs,
+                              const FT_UInt  *gindices,
+                              FTC_SBit       *asbits,
+                              FTC_Node       *anodes )
+  {
+    FT_Error           error;
+    FTC_BasicQueryRec  query;
+    FTC_Node*          nodes;
+    FT_UInt            nn;
+
+
+    if ( !cache || !scaler || !asbits || ( num_glyphs && !gindices ) )
+      return FT_THROW( Invalid_Argument );
+
+    if ( !num_glyphs )
+      return FT_Err_Ok;
+
+    error = ftc_basic_lookup_glyphs_begin( FTC_CACHE( cache ),
+                                           scaler, load_flags, num_glyphs,
+                                           &query, anodes, &nodes );
+    if ( error )
+      return error;
+
+    error = ftc_basic_lookup_glyphs( FTC_GCACHE( cache ), &query,
+                                     ftc_snode_compare,
+                                     FTC_SBIT_ITEMS_PER_NODE,
+                                     num_glyphs, gindices, nodes );
+
+    for ( nn = 0; nn < num_glyphs; nn++ )
+    {
+      FTC_Node  node = nodes[nn];
+
+
+      asbits[nn] = node ? FTC_SNODE( node )->sbits +
+                            ( gindices[nn] - FTC_GNODE( node )->gindex )
+                        : NULL;
+    }
+
+    ftc_basic_lookup_glyphs_end( FTC_CACHE( cache ), num_glyphs,
+                                 anodes, nodes, error );
+
+    return error;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_SBitCache_SetMaxBytes( FTC_SBitCache  cache,
+                             FT_ULong       max_bytes )
+  {
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    FTC_Cache_SetMaxWeight( FTC_CACHE( cache ), max_bytes );
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_SBitCache_GetStats( FTC_SBitCache  cache,
+                          FTC_Stats      astats )
+  {
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    if ( !astats )
+      return FT_THROW( Invalid_Argument );
+
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+    FTC_Cache_GetStats( FTC_CACHE( cache ), astats );
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
+    return FT_Err_Ok;
+  }
+
+
+  /*
+   * Layout of the data written by `FTC_SBitCache_Export'; all values
+   * are big-endian.
+   *
+   *   header:   tag `FTCS' (4 bytes), format version (2 bytes),
+   *             FreeType version (4 bytes), number of glyphs (4 bytes)
+   *
+   *   per glyph: glyph index (4 bytes), width, height, left, top,
+   *              format, max_grays (1 byte each), pitch (2 bytes),
+   *              xadvance, yadvance (1 byte each), followed by
+   *              `abs(pitch) * height' bytes of bitmap data
+   *
+   * The FreeType version is part of the header since the rendering
+   * might change between releases.
+   */
+#define FTC_SBIT_DATA_TAG          FT_MAKE_TAG( 'F', 'T', 'C', 'S' )
+#define FTC_SBIT_DATA_VERSION      1
+#define FTC_SBIT_DATA_FT_VERSION  ( ( FREETYPE_MAJOR << 16 ) | \
+                                    ( FREETYPE_MINOR <<  8 ) | \
+                                      FREETYPE_PATCH         )
+
+#define FTC_SBIT_DATA_HEADER_SIZE  14
+#define FTC_SBIT_DATA_RECORD_SIZE  14
+
+#define FTC_PUT_BYTE( p, v )                \
+          FT_BEGIN_STMNT                    \
+            *(p)++ = (FT_Byte)(v);          \
+          FT_END_STMNT
+
+#define FTC_PUT_USHORT( p, v )              \
+          FT_BEGIN_STMNT                    \
+            FTC_PUT_BYTE( p, (v) >> 8 );    \
+            FTC_PUT_BYTE( p, (v)      );    \
+          FT_END_STMNT
+
+#define FTC_PUT_ULONG( p, v )               \
+          FT_BEGIN_STMNT                    \
+            FTC_PUT_USHORT( p, (v) >> 16 ); \
+            FTC_PUT_USHORT( p, (v)       ); \
+          FT_END_STMNT
+
+
+  /* Check that the pitch of an imported bitmap covers its width. */
+  static FT_Bool
+  ftc_sbit_check_pitch( FTC_SBit  sbit )
+  {
+    FT_UInt  pitch = (FT_UInt)FT_ABS( sbit->pitch );
+    FT_UInt  width = sbit->width;
+
+
+    switch ( sbit->format )
+    {
+    case FT_PIXEL_MODE_MONO:
+      return FT_BOOL( pitch >= ( ( width + 7 ) >> 3 ) );
+
+    case FT_PIXEL_MODE_GRAY2:
+      return FT_BOOL( pitch >= ( ( width + 3 ) >> 2 ) );
+
+    case FT_PIXEL_MODE_GRAY4:
+      return FT_BOOL( pitch >= ( ( width + 1 ) >> 1 ) );
+
+    case FT_PIXEL_MODE_GRAY:
+    case FT_PIXEL_MODE_LCD:
+    case FT_PIXEL_MODE_LCD_V:
+      return FT_BOOL( pitch >= width );
+
+    case FT_PIXEL_MODE_BGRA:
+      return FT_BOOL( pitch >= width * 4 );
+
+    default:
+      return FALSE;
+    }
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_SBitCache_Export( FTC_SBitCache  cache,
+                        FTC_Scaler     scaler,
+                        FT_ULong       load_flags,
+                        FT_Byte*       buffer,
+                        FT_ULong      *alength )
+  {
+    FTC_Cache         ftccache = FTC_CACHE( cache );
+    FTC_BasicAttrRec  attrs;
+    FT_ULong          max_length;
+    FT_ULong          length     = FTC_SBIT_DATA_HEADER_SIZE;
+    FT_ULong          num_glyphs = 0;
+    FT_Byte*          p          = NULL;
+    FT_UFast          i;
+
+
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    if ( !scaler || !alength )
+      return FT_THROW( Invalid_Argument );
+
+    max_length = *alength;
+    if ( max_length && ( !buffer                                  ||
+                         max_length < FTC_SBIT_DATA_HEADER_SIZE ) )
+      return FT_THROW( Invalid_Argument );
+
+    attrs.scaler     = scaler[0];
+    attrs.load_flags = (FT_Int32)load_flags;
+
+    if ( max_length )
+      p = buffer + FTC_SBIT_DATA_HEADER_SIZE;
+
+    FTC_MANAGER_LOCK( ftccache->manager );
+
+    for ( i = 0; i < ftccache->p; i++ )
+    {
+      FTC_Node  node;
+
+
+      for ( node = ftccache->buckets[i]; node; node = node->link )
+      {
+        FTC_SNode        snode  = FTC_SNODE( node );
+        FTC_BasicFamily  family = (FTC_BasicFamily)FTC_SNODE_FAMILY( snode );
+        FT_UInt          nn;
+
+
+        if ( !family || !FTC_BASIC_ATTR_COMPARE( &family->attrs, &attrs ) )
+          continue;
+
+        for ( nn = 0; nn < snode->count; nn++ )
+        {
+          FTC_SBit  sbit = snode->sbits + nn;
+          FT_ULong  size;
+
+
+          /* skip bitmaps that are not loaded or unavailable */
+          if ( !sbit->buffer && sbit->width == 255 )
+            continue;
+
+          size = (FT_ULong)FT_ABS( sbit->pitch ) * sbit->height;
+
+          if ( max_length )
+          {
+            FT_ULong  gindex = FTC_SNODE_GINDEX( snode ) + nn;
+
+
+            /* only write records that fit completely */
+            if ( FTC_SBIT_DATA_RECORD_SIZE + size > max_length - length )
+              continue;
+
+            FTC_PUT_ULONG ( p, gindex );
+            FTC_PUT_BYTE  ( p, sbit->width );
+            FTC_PUT_BYTE  ( p, sbit->height );
+            FTC_PUT_BYTE  ( p, sbit->left );
+            FTC_PUT_BYTE  ( p, sbit->top );
+            FTC_PUT_BYTE  ( p, sbit->format );
+            FTC_PUT_BYTE  ( p, sbit->max_grays );
+            FTC_PUT_USHORT( p, (FT_UShort)sbit->pitch );
+            FTC_PUT_BYTE  ( p, sbit->xadvance );
+            FTC_PUT_BYTE  ( p, sbit->yadvance );
+
+            if ( size )
+            {
+              FT_MEM_COPY( p, sbit->buffer, size );
+              p += size;
+            }
+          }
+
+          length += FTC_SBIT_DATA_RECORD_SIZE + size;
+          num_glyphs++;
+        }
+      }
+    }
+
+    FTC_MANAGER_UNLOCK( ftccache->manager );
+
+    if ( max_length )
+    {
+      p = buffer;
+
+      FTC_PUT_ULONG ( p, FTC_SBIT_DATA_TAG );
+      FTC_PUT_USHORT( p, FTC_SBIT_DATA_VERSION );
+      FTC_PUT_ULONG ( p, FTC_SBIT_DATA_FT_VERSION );
+      FTC_PUT_ULONG ( p, num_glyphs );
+    }
+
+    *alength = length;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_SBitCache_Import( FTC_SBitCache   cache,
+                        FTC_Scaler      scaler,
+                        FT_ULong        load_flags,
+                        const FT_Byte*  buffer,
+                        FT_ULong        length )
+  {
+    FT_Error           error;
+    FTC_BasicQueryRec  query;
+    FTC_MruNode        mrunode;
+    FTC_Family         family;
+    FT_Offset          family_hash;
+    const FT_Byte*     p;
+    const FT_Byte*     limit;
+    FT_ULong           num_glyphs;
+
+
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    if ( !scaler || !buffer )
+      return FT_THROW( Invalid_Argument );
+
+    if ( length < FTC_SBIT_DATA_HEADER_SIZE )
+      return FT_THROW( Invalid_File_Format );
+
+    p     = buffer;
+    limit = buffer + length;
+
+    if ( FT_NEXT_ULONG( p ) != FTC_SBIT_DATA_TAG )
+      return FT_THROW( Invalid_File_Format );
+
+    if ( FT_NEXT_USHORT( p ) != FTC_SBIT_DATA_VERSION    ||
+         FT_NEXT_ULONG( p )  != FTC_SBIT_DATA_FT_VERSION )
+      return FT_THROW( Invalid_Version );
+
+    num_glyphs = FT_NEXT_ULONG( p );
+
+    query.attrs.scaler     = scaler[0];
+    query.attrs.load_flags = (FT_Int32)load_flags;
+    query.gquery.gindex    = 0;
+
+    family_hash = FTC_BASIC_ATTR_HASH( &query.attrs );
+
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+
+    FTC_MRULIST_LOOKUP( &FTC_GCACHE( cache )->families, &query,
+                        mrunode, error );
+    if ( error )
+      goto Exit;
+
+    family              = FTC_FAMILY( mrunode );
+    query.gquery.family = family;
+
+    /* keep the family alive during the whole run */
+    family->num_nodes++;
+
+    for ( ; num_glyphs > 0; num_glyphs-- )
+    {
+      FTC_SBitRec  sbit;
+      FT_UInt      gindex;
+      FT_ULong     size;
+      FT_Offset    hash;
+
+
+      if ( limit - p < FTC_SBIT_DATA_RECORD_SIZE )
+      {
+        error = FT_THROW( Invalid_File_Format );
+        break;
+      }
+
+      gindex         = (FT_UInt)FT_NEXT_ULONG( p );
+      sbit.width     = FT_NEXT_BYTE( p );
+      sbit.height    = FT_NEXT_BYTE( p );
+      sbit.left      = FT_NEXT_CHAR( p );
+      sbit.top       = FT_NEXT_CHAR( p );
+      sbit.format    = FT_NEXT_BYTE( p );
+      sbit.max_grays = FT_NEXT_BYTE( p );
+      sbit.pitch     = FT_NEXT_SHORT( p );
+      sbit.xadvance  = FT_NEXT_CHAR( p );
+      sbit.yadvance  = FT_NEXT_CHAR( p );
+      sbit.buffer    = NULL;
+
+      size = (FT_ULong)FT_ABS( sbit.pitch ) * sbit.height;
+
+      /* a width of 255 without data tags unavailable bitmaps, which */
+      /* `FTC_SBitCache_Export' never writes                          */
+      if ( ( sbit.width == 255 && !size )     ||
+           !ftc_sbit_check_pitch( &sbit )     ||
+           size > (FT_ULong)( limit - p )     )
+      {
+        error = FT_THROW( Invalid_File_Format );
+        break;
+      }
+
+      query.gquery.gindex = gindex;
+
+      hash = family_hash + gindex / FTC_SBIT_ITEMS_PER_NODE;
+
+      error = FTC_SNode_Import( FTC_CACHE( cache ), hash,
+                                FTC_GQUERY( &query ), &sbit, p );
+      if ( error )
+        break;
+
+      p += size;
+    }
+
+    if ( --family->num_nodes == 0 )
+      FTC_FAMILY_FREE( family, cache );
+
+  Exit:
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
     return error;
   }
 
@@ -289,7 +289,16 @@
     }
 #endif
 
-    manager->cur_weight -= cache->clazz.node_weight( node, cache );
+    {
+      FT_Offset  weight = cache->clazz.node_weight( node, cache );
+
+
+      manager->cur_weight -= weight;
+      cache->cur_weight   -= weight;
+    }
+
+    cache->num_nodes--;
+    cache->num_evictions++;
 
     /* remove node from mru list */
     ftc_node_mru_unlink( node, manager );
@@ -329,6 +338,14 @@
     cache->mask  = FTC_HASH_INITIAL_SIZE - 1;
     cache->slack = FTC_HASH_INITIAL_SIZE * FTC_HASH_MAX_LOAD;
 
+    cache->max_weight = 0;
+    cache->cur_weight = 0;
+    cache->num_nodes  = 0;
+
+    cache->num_lookups   = 0;
+    cache->num_misses    = 0;
+    cache->num_evictions = 0;
+
     FT_MEM_NEW_ARRAY( cache->buckets, FTC_HASH_INITIAL_SIZE );
     return error;
   }
@@ -378,9 +395,11 @@
 
     FT_FREE( cache->buckets );
 
-    cache->p     = 0;
-    cache->mask  = 0;
-    cache->slack = 0;
+    cache->p          = 0;
+    cache->mask       = 0;
+    cache->slack      = 0;
+    cache->cur_weight = 0;
+    cache->num_nodes  = 0;
   }
 
 
@@ -391,7 +410,7 @@
   }
 
 
-  static void
+  FT_LOCAL_DEF( void )
   ftc_cache_add( FTC_Cache  cache,
                  FT_Offset  hash,
                  FTC_Node   node )
@@ -399,17 +418,22 @@
     node->hash        = hash;
     node->cache_index = (FT_UShort)cache->index;
     node->ref_count   = 0;
+    node->flags       = 0;
 
     ftc_node_hash_link( node, cache );
     ftc_node_mru_link( node, cache->manager );
 
     {
       FTC_Manager  manager = cache->manager;
+      FT_Offset    weight  = cache->clazz.node_weight( node, cache );
 
 
-      manager->cur_weight += cache->clazz.node_weight( node, cache );
+      manager->cur_weight += weight;
+      cache->cur_weight   += weight;
+      cache->num_nodes++;
 
-      if ( manager->cur_weight >= manager->max_weight )
+      if ( manager->cur_weight >= manager->max_weight ||
+           FTC_CACHE_OVER_BUDGET( cache )             )
       {
         node->ref_count++;
         FTC_Manager_Compress( manager );
@@ -429,6 +453,8 @@
     FTC_Node  node;
 
 
+    cache->num_misses++;
+
     /*
      * We use the FTC_CACHE_TRYLOOP macros to support out-of-memory
      * errors (OOM) correctly, i.e., by flushing the cache progressively
@@ -476,6 +502,8 @@
     if ( !cache || !anode )
       return FT_THROW( Invalid_Argument );
 
+    cache->num_lookups++;
+
     /* Go to the `top' node of the list sharing same masked hash */
     bucket = pnode = FTC_NODE_TOP_FOR_HASH( cache, hash );
 
@@ -525,7 +553,9 @@
       FTC_Manager  manager = cache->manager;
 
 
-      if ( node != manager->nodes_list )
+      if ( manager->policy == FTC_EVICTION_POLICY_CLOCK )
+        node->flags |= FTC_NODE_FLAG_REFERENCED;
+      else if ( node != manager->nodes_list )
         ftc_node_mru_up( node, manager );
     }
     *anode = node;
@@ -563,9 +593,14 @@
 
         if ( cache->clazz.node_remove_faceid( node, face_id, cache, NULL ) )
         {
+          FT_Offset  weight = cache->clazz.node_weight( node, cache );
+
+
           *pnode = node->link;
 
-          manager->cur_weight -= cache->clazz.node_weight( node, cache );
+          manager->cur_weight -= weight;
+          cache->cur_weight   -= weight;
+          cache->num_nodes--;
           ftc_node_mru_unlink( node, manager );
 
           cache->clazz.node_free( node, cache );
@@ -581,4 +616,34 @@
   }
 
 
+  FT_LOCAL_DEF( void )
+  FTC_Cache_SetMaxWeight( FTC_Cache  cache,
+                          FT_Offset  max_weight )
+  {
+    FTC_Manager  manager = cache->manager;
+
+
+    FTC_MANAGER_LOCK( manager );
+
+    cache->max_weight = max_weight;
+    if ( FTC_CACHE_OVER_BUDGET( cache ) )
+      FTC_Manager_Compress( manager );
+
+    FTC_MANAGER_UNLOCK( manager );
+  }
+
+
+  FT_LOCAL_DEF( void )
+  FTC_Cache_GetStats( FTC_Cache  cache,
+                      FTC_Stats  stats )
+  {
+    stats->lookups   = cache->num_lookups;
+    stats->misses    = cache->num_misses;
+    stats->hits      = cache->num_lookups - cache->num_misses;
+    stats->evictions = cache->num_evictions;
+    stats->num_nodes = cache->num_nodes;
+    stats->num_bytes = cache->cur_weight;
+  }
+
+
 /* END */
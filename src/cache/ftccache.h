@@ -54,7 +54,7 @@ FT_BEGIN_HEADER
    *
    */
 
-  /* structure size should be 20 bytes on 32-bits machines */
+  /* structure size should be 24 bytes on 32-bits machines */
   typedef struct  FTC_NodeRec_
   {
     FTC_MruNodeRec  mru;          /* circular mru list pointer           */
@@ -62,10 +62,16 @@ FT_BEGIN_HEADER
     FT_Offset       hash;         /* used for hashing too                */
     FT_UShort       cache_index;  /* index of cache the node belongs to  */
     FT_Short        ref_count;    /* reference count for this node       */
+    FT_UShort       flags;        /* FTC_NODE_FLAG_XXX                   */
 
   } FTC_NodeRec;
 
 
+  /* set on a cache hit if the CLOCK eviction policy is active; */
+  /* such a node gets a second chance before being flushed      */
+#define FTC_NODE_FLAG_REFERENCED  1U
+
+
 #define FTC_NODE( x )    ( (FTC_Node)(x) )
 #define FTC_NODE_P( x )  ( (FTC_Node*)(x) )
 
@@ -162,9 +168,22 @@ FT_BEGIN_HEADER
 
     FTC_CacheClass     org_class;   /* original class pointer */
 
+    FT_Offset          max_weight;  /* 0 if no private budget */
+    FT_Offset          cur_weight;
+    FT_UInt            num_nodes;
+
+    FT_ULong           num_lookups; /* statistics, see FTC_StatsRec */
+    FT_ULong           num_misses;
+    FT_ULong           num_evictions;
+
   } FTC_CacheRec;
 
 
+#define FTC_CACHE_OVER_BUDGET( cache )                 \
+          ( (cache)->max_weight                     && \
+            (cache)->cur_weight > (cache)->max_weight )
+
+
 #define FTC_CACHE( x )    ( (FTC_Cache)(x) )
 #define FTC_CACHE_P( x )  ( (FTC_Cache*)(x) )
 
@@ -197,6 +216,13 @@ FT_BEGIN_HEADER
                      FT_Pointer  query,
                      FTC_Node   *anode );
 
+  /* Link a node created outside of `FTC_Cache_NewNode' into the  */
+  /* cache, flushing old nodes if the cache budget is exceeded.   */
+  FT_LOCAL( void )
+  ftc_cache_add( FTC_Cache  cache,
+                 FT_Offset  hash,
+                 FTC_Node   node );
+
   /* Remove all nodes that relate to a given face_id.  This is useful
    * when un-installing fonts.  Note that if a cache node relates to
    * the face_id but is locked (i.e., has `ref_count > 0'), the node
@@ -211,6 +237,18 @@ FT_BEGIN_HEADER
   FTC_Cache_RemoveFaceID( FTC_Cache   cache,
                           FTC_FaceID  face_id );
 
+  /* Set the maximum weight of a given cache's nodes; 0 means that  */
+  /* only the global limit of the manager applies.  Nodes are       */
+  /* flushed immediately if the cache is above its new budget.      */
+  FT_LOCAL( void )
+  FTC_Cache_SetMaxWeight( FTC_Cache  cache,
+                          FT_Offset  max_weight );
+
+  /* Retrieve the statistics of a given cache. */
+  FT_LOCAL( void )
+  FTC_Cache_GetStats( FTC_Cache  cache,
+                      FTC_Stats  stats );
+
 
 #ifdef FTC_INLINE
 
@@ -226,6 +264,8 @@ FT_BEGIN_HEADER
     error = FT_Err_Ok;                                                   \
     node  = NULL;                                                        \
                                                                          \
+    _cache->num_lookups++;                                               \
+                                                                         \
     /* Go to the `top' node of the list sharing same masked hash */      \
     _bucket = _pnode = FTC_NODE_TOP_FOR_HASH( _cache, _hash );           \
                                                                          \
@@ -276,7 +316,9 @@ FT_BEGIN_HEADER
       void*        _nl      = &_manager->nodes_list;                     \
                                                                          \
                                                                          \
-      if ( _node != _manager->nodes_list )                               \
+      if ( _manager->policy == FTC_EVICTION_POLICY_CLOCK )               \
+        _node->flags |= FTC_NODE_FLAG_REFERENCED;                        \
+      else if ( _node != _manager->nodes_list )                          \
         FTC_MruNode_Up( (FTC_MruNode*)_nl,                               \
                         (FTC_MruNode)_node );                            \
     }                                                                    \
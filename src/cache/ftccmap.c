@@ -239,6 +239,7 @@
     FT_UInt           gindex = 0;
     FT_Offset         hash;
     FT_Int            no_cmap_change = 0;
+    FT_ULong          num_misses;
 
 
     if ( cmap_index < 0 )
@@ -264,6 +265,10 @@
 
     hash = FTC_CMAP_HASH( face_id, (FT_UInt)cmap_index, char_code );
 
+    FTC_MANAGER_LOCK( cache->manager );
+
+    num_misses = cache->num_misses;
+
 #ifdef FTC_INLINE
     FTC_CACHE_LOOKUP_CMP( cache, ftc_cmap_node_compare, hash, &query,
                           node, error );
@@ -278,7 +283,7 @@
 
     /* something rotten can happen with rogue clients */
     if ( char_code - FTC_CMAP_NODE( node )->first >= FTC_CMAP_INDICES_MAX )
-      return 0; /* XXX: should return appropriate error */
+      goto Exit; /* XXX: should return appropriate error */
 
     gindex = FTC_CMAP_NODE( node )->indices[char_code -
                                             FTC_CMAP_NODE( node )->first];
@@ -289,9 +294,13 @@
 
       gindex = 0;
 
-      error = FTC_Manager_LookupFace( cache->manager,
-                                      FTC_CMAP_NODE( node )->face_id,
-                                      &face );
+      /* a new node has already been counted as a miss */
+      if ( cache->num_misses == num_misses )
+        cache->num_misses++;
+
+      error = ftc_manager_lookup_face( cache->manager,
+                                       FTC_CMAP_NODE( node )->face_id,
+                                       &face );
       if ( error )
         goto Exit;
 
@@ -316,8 +325,45 @@
     }
 
   Exit:
+    FTC_MANAGER_UNLOCK( cache->manager );
+
     return gindex;
   }
 
 
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_CMapCache_SetMaxBytes( FTC_CMapCache  cache,
+                             FT_ULong       max_bytes )
+  {
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    FTC_Cache_SetMaxWeight( FTC_CACHE( cache ), max_bytes );
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_CMapCache_GetStats( FTC_CMapCache  cache,
+                          FTC_Stats      astats )
+  {
+    if ( !cache )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    if ( !astats )
+      return FT_THROW( Invalid_Argument );
+
+    FTC_MANAGER_LOCK( FTC_CACHE( cache )->manager );
+    FTC_Cache_GetStats( FTC_CACHE( cache ), astats );
+    FTC_MANAGER_UNLOCK( FTC_CACHE( cache )->manager );
+
+    return FT_Err_Ok;
+  }
+
+
 /* END */
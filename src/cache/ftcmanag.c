@@ -39,7 +39,7 @@
     FT_Error  error;
 
 
-    error = FTC_Manager_LookupFace( manager, scaler->face_id, &face );
+    error = ftc_manager_lookup_face( manager, scaler->face_id, &face );
     if ( error )
       goto Exit;
 
@@ -157,25 +157,17 @@
   }
 
 
-  /* documentation is in ftcache.h */
-
-  FT_EXPORT_DEF( FT_Error )
-  FTC_Manager_LookupSize( FTC_Manager  manager,
-                          FTC_Scaler   scaler,
-                          FT_Size     *asize )
+  FT_LOCAL_DEF( FT_Error )
+  ftc_manager_lookup_size( FTC_Manager  manager,
+                           FTC_Scaler   scaler,
+                           FT_Size     *asize )
   {
     FT_Error     error;
     FTC_MruNode  mrunode;
 
 
-    if ( !asize || !scaler )
-      return FT_THROW( Invalid_Argument );
-
     *asize = NULL;
 
-    if ( !manager )
-      return FT_THROW( Invalid_Cache_Handle );
-
 #ifdef FTC_INLINE
 
     FTC_MRULIST_LOOKUP_CMP( &manager->sizes, scaler, ftc_size_node_compare,
@@ -192,6 +184,32 @@
   }
 
 
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_Manager_LookupSize( FTC_Manager  manager,
+                          FTC_Scaler   scaler,
+                          FT_Size     *asize )
+  {
+    FT_Error  error;
+
+
+    if ( !asize || !scaler )
+      return FT_THROW( Invalid_Argument );
+
+    *asize = NULL;
+
+    if ( !manager )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    FTC_MANAGER_LOCK( manager );
+    error = ftc_manager_lookup_size( manager, scaler, asize );
+    FTC_MANAGER_UNLOCK( manager );
+
+    return error;
+  }
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*****                                                               *****/
@@ -285,25 +303,17 @@
   };
 
 
-  /* documentation is in ftcache.h */
-
-  FT_EXPORT_DEF( FT_Error )
-  FTC_Manager_LookupFace( FTC_Manager  manager,
-                          FTC_FaceID   face_id,
-                          FT_Face     *aface )
+  FT_LOCAL_DEF( FT_Error )
+  ftc_manager_lookup_face( FTC_Manager  manager,
+                           FTC_FaceID   face_id,
+                           FT_Face     *aface )
   {
     FT_Error     error;
     FTC_MruNode  mrunode;
 
 
-    if ( !aface )
-      return FT_THROW( Invalid_Argument );
-
     *aface = NULL;
 
-    if ( !manager )
-      return FT_THROW( Invalid_Cache_Handle );
-
     /* we break encapsulation for the sake of speed */
 #ifdef FTC_INLINE
 
@@ -321,6 +331,32 @@
   }
 
 
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_Manager_LookupFace( FTC_Manager  manager,
+                          FTC_FaceID   face_id,
+                          FT_Face     *aface )
+  {
+    FT_Error  error;
+
+
+    if ( !aface )
+      return FT_THROW( Invalid_Argument );
+
+    *aface = NULL;
+
+    if ( !manager )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    FTC_MANAGER_LOCK( manager );
+    error = ftc_manager_lookup_face( manager, face_id, aface );
+    FTC_MANAGER_UNLOCK( manager );
+
+    return error;
+  }
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*****                                                               *****/
@@ -370,10 +406,15 @@
     manager->memory       = memory;
     manager->max_weight   = max_bytes;
     manager->cur_weight   = 0;
+    manager->policy       = FTC_EVICTION_POLICY_LRU;
 
     manager->request_face = requester;
     manager->request_data = req_data;
 
+    manager->lock      = NULL;
+    manager->unlock    = NULL;
+    manager->lock_data = NULL;
+
     FTC_MruList_Init( &manager->faces,
                       &ftc_face_list_class,
                       max_faces,
@@ -440,10 +481,119 @@
     if ( !manager )
       return;
 
+    FTC_MANAGER_LOCK( manager );
+
     FTC_MruList_Reset( &manager->sizes );
     FTC_MruList_Reset( &manager->faces );
 
     FTC_Manager_FlushN( manager, manager->num_nodes );
+
+    FTC_MANAGER_UNLOCK( manager );
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_Manager_SetEvictionPolicy( FTC_Manager          manager,
+                                 FTC_Eviction_Policy  policy )
+  {
+    if ( !manager )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    if ( (FT_UInt)policy >= FTC_EVICTION_POLICY_MAX )
+      return FT_THROW( Invalid_Argument );
+
+    FTC_MANAGER_LOCK( manager );
+
+    /* drop pending second chances when leaving the CLOCK policy */
+    if ( manager->policy == FTC_EVICTION_POLICY_CLOCK &&
+         policy != FTC_EVICTION_POLICY_CLOCK          &&
+         manager->nodes_list                          )
+    {
+      FTC_Node  node = manager->nodes_list;
+
+
+      do
+      {
+        node->flags &= ~FTC_NODE_FLAG_REFERENCED;
+        node         = FTC_NODE_NEXT( node );
+
+      } while ( node != manager->nodes_list );
+    }
+
+    manager->policy = policy;
+
+    FTC_MANAGER_UNLOCK( manager );
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_Manager_GetStats( FTC_Manager  manager,
+                        FTC_Stats    astats )
+  {
+    FT_UInt  nn;
+
+
+    if ( !manager )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    if ( !astats )
+      return FT_THROW( Invalid_Argument );
+
+    FTC_MANAGER_LOCK( manager );
+
+    astats->lookups   = 0;
+    astats->hits      = 0;
+    astats->misses    = 0;
+    astats->evictions = 0;
+
+    for ( nn = 0; nn < manager->num_caches; nn++ )
+    {
+      FTC_StatsRec  stats;
+
+
+      FTC_Cache_GetStats( manager->caches[nn], &stats );
+
+      astats->lookups   += stats.lookups;
+      astats->hits      += stats.hits;
+      astats->misses    += stats.misses;
+      astats->evictions += stats.evictions;
+    }
+
+    astats->num_nodes = manager->num_nodes;
+    astats->num_bytes = manager->cur_weight;
+
+    FTC_MANAGER_UNLOCK( manager );
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_Manager_SetLock( FTC_Manager           manager,
+                       FTC_Manager_LockFunc  lock,
+                       FTC_Manager_LockFunc  unlock,
+                       FT_Pointer            lock_data )
+  {
+    if ( !manager )
+      return FT_THROW( Invalid_Cache_Handle );
+
+    /* both functions or none */
+    if ( !lock != !unlock )
+      return FT_THROW( Invalid_Argument );
+
+    manager->lock      = lock;
+    manager->unlock    = unlock;
+    manager->lock_data = lock_data;
+
+    return FT_Err_Ok;
   }
 
 
@@ -509,16 +659,45 @@
 #endif /* FT_DEBUG_ERROR */
 
 
+  /* Check whether an unreferenced node can be flushed.  With the  */
+  /* CLOCK policy, a node that has been hit since the last check    */
+  /* gets a second chance instead: its flag is cleared and it moves */
+  /* to the head of the MRU list.                                   */
+  static FT_Bool
+  ftc_node_evictable( FTC_Node     node,
+                      FTC_Manager  manager )
+  {
+    if ( node->ref_count > 0 )
+      return FALSE;
+
+    if ( node->flags & FTC_NODE_FLAG_REFERENCED )
+    {
+      void  *nl = &manager->nodes_list;
+
+
+      node->flags &= ~FTC_NODE_FLAG_REFERENCED;
+      FTC_MruNode_Up( (FTC_MruNode*)nl,
+                      (FTC_MruNode)node );
+      return FALSE;
+    }
+
+    return TRUE;
+  }
+
+
   /* `Compress' the manager's data, i.e., get rid of old cache nodes */
   /* that are not referenced anymore in order to limit the total     */
-  /* memory used by the cache.                                       */
+  /* memory used by the cache and by each cache with a budget.       */
 
   /* documentation is in ftcmanag.h */
 
   FT_LOCAL_DEF( void )
   FTC_Manager_Compress( FTC_Manager  manager )
   {
-    FTC_Node   node, prev, first;
+    FTC_Node  node, prev, first;
+    FT_UInt   num_over = 0;
+    FT_UInt   pass;
+    FT_UInt   nn;
 
 
     if ( !manager )
@@ -534,20 +713,55 @@
                 manager->num_nodes ));
 #endif
 
-    if ( manager->cur_weight < manager->max_weight || !first )
+    for ( nn = 0; nn < manager->num_caches; nn++ )
+      if ( FTC_CACHE_OVER_BUDGET( manager->caches[nn] ) )
+        num_over++;
+
+    if ( ( manager->cur_weight < manager->max_weight && !num_over ) ||
+         !first                                                     )
       return;
 
-    /* go to last node -- it's a circular list */
-    prev = FTC_NODE_PREV( first );
-    do
+    /* A second pass is only needed if the first one handed out */
+    /* second chances (CLOCK policy) without freeing enough.    */
+    for ( pass = 0; pass < 2; pass++ )
     {
-      node = prev;
-      prev = FTC_NODE_PREV( node );
+      first = manager->nodes_list;
+      if ( !first )
+        break;
 
-      if ( node->ref_count <= 0 )
-        ftc_node_destroy( node, manager );
+      /* go to last node -- it's a circular list */
+      prev = FTC_NODE_PREV( first );
+      do
+      {
+        FTC_Cache  cache;
+
+
+        node  = prev;
+        prev  = FTC_NODE_PREV( node );
+        cache = manager->caches[node->cache_index];
+
+        if ( manager->cur_weight > manager->max_weight ||
+             FTC_CACHE_OVER_BUDGET( cache )             )
+        {
+          FT_Bool  over = FTC_CACHE_OVER_BUDGET( cache );
 
-    } while ( node != first && manager->cur_weight > manager->max_weight );
+
+          if ( ftc_node_evictable( node, manager ) )
+          {
+            ftc_node_destroy( node, manager );
+
+            if ( over && !FTC_CACHE_OVER_BUDGET( cache ) )
+              num_over--;
+          }
+        }
+
+      } while ( node != first                                  &&
+                ( manager->cur_weight > manager->max_weight ||
+                  num_over                                   ) );
+
+      if ( manager->cur_weight <= manager->max_weight && !num_over )
+        break;
+    }
   }
 
 
@@ -649,6 +863,8 @@
     if ( !manager )
       return;
 
+    FTC_MANAGER_LOCK( manager );
+
     /* this will remove all FTC_SizeNode that correspond to
      * the face_id as well
      */
@@ -658,6 +874,8 @@
 
     for ( nn = 0; nn < manager->num_caches; nn++ )
       FTC_Cache_RemoveFaceID( manager->caches[nn], face_id );
+
+    FTC_MANAGER_UNLOCK( manager );
   }
 
 
@@ -670,7 +888,11 @@
     if ( node                                    &&
          manager                                 &&
          node->cache_index < manager->num_caches )
+    {
+      FTC_MANAGER_LOCK( manager );
       node->ref_count--;
+      FTC_MANAGER_UNLOCK( manager );
+    }
   }
 
 
@@ -96,6 +96,7 @@ FT_BEGIN_HEADER
     FT_Offset           max_weight;
     FT_Offset           cur_weight;
     FT_UInt             num_nodes;
+    FTC_Eviction_Policy policy;
 
     FTC_Cache           caches[FTC_MAX_CACHES];
     FT_UInt             num_caches;
@@ -106,9 +107,28 @@ FT_BEGIN_HEADER
     FT_Pointer          request_data;
     FTC_Face_Requester  request_face;
 
+    FTC_Manager_LockFunc  lock;
+    FTC_Manager_LockFunc  unlock;
+    FT_Pointer            lock_data;
+
   } FTC_ManagerRec;
 
 
+  /* Serialize access to the manager if the client has installed */
+  /* lock functions with `FTC_Manager_SetLock'.                  */
+#define FTC_MANAGER_LOCK( m )                 \
+  FT_BEGIN_STMNT                              \
+    if ( (m)->lock )                          \
+      (m)->lock( (m)->lock_data );            \
+  FT_END_STMNT
+
+#define FTC_MANAGER_UNLOCK( m )               \
+  FT_BEGIN_STMNT                              \
+    if ( (m)->unlock )                        \
+      (m)->unlock( (m)->lock_data );          \
+  FT_END_STMNT
+
+
   /**************************************************************************
    *
    * @Function:
@@ -116,9 +136,10 @@ FT_BEGIN_HEADER
    *
    * @Description:
    *   This function is used to check the state of the cache manager if
-   *   its `num_bytes' field is greater than its `max_bytes' field.  It
-   *   will flush as many old cache nodes as possible (ignoring cache
-   *   nodes with a non-zero reference count).
+   *   its `num_bytes' field is greater than its `max_bytes' field, or if
+   *   a cache exceeds its private budget.  It will flush as many old
+   *   cache nodes as possible (ignoring cache nodes with a non-zero
+   *   reference count).
    *
    * @InOut:
    *   manager ::
@@ -143,6 +164,20 @@ FT_BEGIN_HEADER
                       FT_UInt      count );
 
 
+  /* Unlocked versions of `FTC_Manager_LookupFace' and           */
+  /* `FTC_Manager_LookupSize', to be used by cache implementations */
+  /* that already hold the manager lock.                           */
+  FT_LOCAL( FT_Error )
+  ftc_manager_lookup_face( FTC_Manager  manager,
+                           FTC_FaceID   face_id,
+                           FT_Face     *aface );
+
+  FT_LOCAL( FT_Error )
+  ftc_manager_lookup_size( FTC_Manager  manager,
+                           FTC_Scaler   scaler,
+                           FT_Size     *asize );
+
+
   /* this must be used internally for the moment */
   FT_LOCAL( FT_Error )
   FTC_Manager_RegisterCache( FTC_Manager      manager,
@@ -209,10 +209,12 @@
   }
 
 
-  FT_LOCAL_DEF( FT_Error )
-  FTC_SNode_New( FTC_SNode  *psnode,
-                 FTC_GQuery  gquery,
-                 FTC_Cache   cache )
+  /* Create an snode for the range holding `gquery->gindex'; */
+  /* all its bitmaps are marked as not loaded yet.           */
+  static FT_Error
+  ftc_snode_alloc( FTC_SNode  *psnode,
+                   FTC_GQuery  gquery,
+                   FTC_Cache   cache )
   {
     FT_Memory   memory = cache->memory;
     FT_Error    error;
@@ -251,10 +253,29 @@
         snode->sbits[node_count].height = 0;
         snode->sbits[node_count].buffer = NULL;
       }
+    }
+
+  Exit:
+    *psnode = snode;
+    return error;
+  }
 
+
+  FT_LOCAL_DEF( FT_Error )
+  FTC_SNode_New( FTC_SNode  *psnode,
+                 FTC_GQuery  gquery,
+                 FTC_Cache   cache )
+  {
+    FT_Error   error;
+    FTC_SNode  snode;
+
+
+    error = ftc_snode_alloc( &snode, gquery, cache );
+    if ( !error )
+    {
       error = ftc_snode_load( snode,
                               cache->manager,
-                              gindex,
+                              gquery->gindex,
                               NULL );
       if ( error )
       {
@@ -263,12 +284,86 @@
       }
     }
 
-  Exit:
     *psnode = snode;
     return error;
   }
 
 
+  FT_LOCAL_DEF( FT_Error )
+  FTC_SNode_Import( FTC_Cache       cache,
+                    FT_Offset       hash,
+                    FTC_GQuery      gquery,
+                    FTC_SBit        sbit,
+                    const FT_Byte*  buffer )
+  {
+    FT_Memory  memory = cache->memory;
+    FT_Error   error  = FT_Err_Ok;
+    FT_UInt    gindex = gquery->gindex;
+    FTC_Node   node;
+    FTC_SNode  snode  = NULL;
+    FTC_SBit   dest;
+    FT_ULong   size;
+
+
+    /* find the node holding `gindex' without loading anything */
+    for ( node = *FTC_NODE_TOP_FOR_HASH( cache, hash );
+          node;
+          node = node->link )
+    {
+      FTC_GNode  gnode = FTC_GNODE( node );
+
+
+      if ( node->hash == hash                     &&
+           gnode->family == gquery->family        &&
+           gindex - gnode->gindex < FTC_SNODE( node )->count )
+      {
+        snode = FTC_SNODE( node );
+        break;
+      }
+    }
+
+    if ( !snode )
+    {
+      error = ftc_snode_alloc( &snode, gquery, cache );
+      if ( error )
+        goto Exit;
+
+      ftc_cache_add( cache, hash, FTC_NODE( snode ) );
+    }
+
+    dest = snode->sbits + ( gindex - FTC_GNODE( snode )->gindex );
+
+    /* never replace a bitmap that has already been loaded */
+    if ( dest->buffer || dest->width != 255 )
+      goto Exit;
+
+    size = (FT_ULong)FT_ABS( sbit->pitch ) * sbit->height;
+
+    if ( size )
+    {
+      FT_MEM_DUP( dest->buffer, buffer, size );
+      if ( error )
+        goto Exit;
+    }
+
+    dest->width     = sbit->width;
+    dest->height    = sbit->height;
+    dest->left      = sbit->left;
+    dest->top       = sbit->top;
+    dest->format    = sbit->format;
+    dest->max_grays = sbit->max_grays;
+    dest->pitch     = sbit->pitch;
+    dest->xadvance  = sbit->xadvance;
+    dest->yadvance  = sbit->yadvance;
+
+    cache->manager->cur_weight += size;
+    cache->cur_weight          += size;
+
+  Exit:
+    return error;
+  }
+
+
   FT_LOCAL_DEF( FT_Error )
   ftc_snode_new( FTC_Node   *ftcpsnode,
                  FT_Pointer  ftcgquery,
@@ -389,6 +484,8 @@
         FT_Error  error;
 
 
+        cache->num_misses++;
+
         ftcsnode->ref_count++;  /* lock node to prevent flushing */
                                 /* in retry loop                 */
 
@@ -403,7 +500,10 @@
         if ( error )
           result = 0;
         else
+        {
           cache->manager->cur_weight += size;
+          cache->cur_weight          += size;
+        }
       }
     }
 
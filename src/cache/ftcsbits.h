@@ -76,6 +76,16 @@ FT_BEGIN_HEADER
                  FTC_GQuery   gquery,
                  FTC_Cache    cache );
 
+  /* Store the metrics of `sbit' and a copy of `buffer' as the bitmap */
+  /* of glyph `gquery->gindex', creating the node with the given hash  */
+  /* if necessary.  Glyphs that are already loaded are left untouched. */
+  FT_LOCAL( FT_Error )
+  FTC_SNode_Import( FTC_Cache       cache,
+                    FT_Offset       hash,
+                    FTC_GQuery      gquery,
+                    FTC_SBit        sbit,
+                    const FT_Byte*  buffer );
+
 #if 0
   FT_LOCAL( FT_ULong )
   FTC_SNode_Weight( FTC_SNode  inode );
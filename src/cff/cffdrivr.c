@@ -645,10 +645,84 @@
   }
 
 
+  FT_CALLBACK_DEF( FT_UInt )
+  cff_get_char_indices( FT_CharMap        charmap,
+                        const FT_UInt32*  char_codes,
+                        FT_UInt           count,
+                        FT_UInt*          gindices,
+                        FT_Bool           stop )
+  {
+    FT_CMap  cmap = FT_CMAP( charmap );
+    FT_Face  face = FT_CMAP_FACE( cmap );
+    FT_UInt  n;
+
+
+    if ( cmap->clazz != &cff_cmap_encoding_class_rec &&
+         cmap->clazz != &cff_cmap_unicode_class_rec  )
+    {
+      FT_Library          library = FT_FACE_LIBRARY( face );
+      FT_Module           sfnt    = FT_Get_Module( library, "sfnt" );
+      FT_Service_TTCMaps  service =
+        (FT_Service_TTCMaps)ft_module_get_service( sfnt,
+                                                   FT_SERVICE_ID_TT_CMAP,
+                                                   0 );
+
+
+      if ( service && service->char_indices )
+        return service->char_indices( charmap, char_codes, count,
+                                      gindices, stop );
+    }
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_UInt  gindex = cmap->clazz->char_index( cmap, char_codes[n] );
+
+
+      if ( gindex >= (FT_UInt)face->num_glyphs )
+        gindex = 0;
+
+      gindices[n] = gindex;
+
+      if ( stop && !gindex )
+        return n;
+    }
+
+    return count;
+  }
+
+
+  FT_CALLBACK_DEF( FT_Error )
+  cff_get_coverage( FT_CharMap   charmap,
+                    FT_Coverage  coverage )
+  {
+    FT_CMap  cmap = FT_CMAP( charmap );
+
+
+    if ( cmap->clazz != &cff_cmap_encoding_class_rec &&
+         cmap->clazz != &cff_cmap_unicode_class_rec  )
+    {
+      FT_Library          library = FT_FACE_LIBRARY( FT_CMAP_FACE( cmap ) );
+      FT_Module           sfnt    = FT_Get_Module( library, "sfnt" );
+      FT_Service_TTCMaps  service =
+        (FT_Service_TTCMaps)ft_module_get_service( sfnt,
+                                                   FT_SERVICE_ID_TT_CMAP,
+                                                   0 );
+
+
+      if ( service && service->get_coverage )
+        return service->get_coverage( charmap, coverage );
+    }
+
+    return FT_THROW( Unimplemented_Feature );
+  }
+
+
   FT_DEFINE_SERVICE_TTCMAPSREC(
     cff_service_get_cmap_info,
 
-    cff_get_cmap_info  /* TT_CMap_Info_GetFunc get_cmap_info */
+    cff_get_cmap_info,     /* TT_CMap_Info_GetFunc       get_cmap_info */
+    cff_get_char_indices,  /* TT_CMap_Char_Indices_Func  char_indices  */
+    cff_get_coverage       /* TT_CMap_Coverage_Func      get_coverage  */
   )
 
 
@@ -21,6 +21,7 @@
 #include <freetype/internal/sfnt.h>
 #include <freetype/internal/ftcalc.h>
 #include <freetype/internal/psaux.h>
+#include <freetype/internal/services/svmm.h>
 #include <freetype/ftoutln.h>
 #include <freetype/ftdriver.h>
 
@@ -198,6 +199,293 @@
 #endif /* 0 */
 
 
+  /*************************************************************************/
+  /*************************************************************************/
+  /*************************************************************************/
+  /**********                                                      *********/
+  /**********                                                      *********/
+  /**********               CHARSTRING RESULTS CACHE               *********/
+  /**********                                                      *********/
+  /**********    Without hinting, the charstring interpreter       *********/
+  /**********    produces the outline at unity scale, which is     *********/
+  /**********    independent of the size.  We optionally keep      *********/
+  /**********    these outlines to avoid interpreting charstrings  *********/
+  /**********    and their subroutines again.                      *********/
+  /**********                                                      *********/
+  /*************************************************************************/
+  /*************************************************************************/
+  /*************************************************************************/
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   cff_face_done_charstring_cache
+   *
+   * @Description:
+   *   Free the charstring cache of a face.
+   *
+   * @Input:
+   *   face ::
+   *     A handle to the target face object.
+   */
+  FT_LOCAL_DEF( void )
+  cff_face_done_charstring_cache( TT_Face  face )
+  {
+    FT_Memory  memory = face->root.memory;
+    CFF_Font   cff    = (CFF_Font)face->extra.data;
+
+    CFF_CharstringCache  cache;
+    FT_UInt              i;
+
+
+    if ( !cff || !cff->charstring_cache )
+      return;
+
+    cache = (CFF_CharstringCache)cff->charstring_cache;
+
+    for ( i = 0; i < cff->num_glyphs; i++ )
+      FT_FREE( cache->glyphs[i] );
+
+    FT_FREE( cache->glyphs );
+    FT_FREE( cache->coords );
+    FT_FREE( cff->charstring_cache );
+  }
+
+
+  /* check whether the charstring cache can be used for the current glyph */
+  static FT_Bool
+  cff_use_charstring_cache( TT_Face   face,
+                            FT_Int32  load_flags )
+  {
+    PS_Driver  driver = (PS_Driver)FT_FACE_DRIVER( face );
+
+    FT_Char  no_stem_darkening_font = face->root.internal->no_stem_darkening;
+
+
+    /* hinting and stem darkening depend on the size */
+    if ( ( load_flags & FT_LOAD_NO_HINTING ) == 0 )
+      return FALSE;
+
+    if ( ( load_flags & FT_LOAD_NO_SCALE ) == 0          &&
+         ( !no_stem_darkening_font                     ||
+           ( no_stem_darkening_font < 0    &&
+             !driver->no_stem_darkening  ) )           )
+      return FALSE;
+
+    /* we only cache complete outlines */
+    if ( load_flags & ( FT_LOAD_NO_RECURSE | FT_LOAD_ADVANCE_ONLY ) )
+      return FALSE;
+
+#ifdef CFF_CONFIG_OPTION_OLD_ENGINE
+    if ( driver->hinting_engine == FT_HINTING_FREETYPE )
+      return FALSE;
+#endif
+
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+    /* glyph data might change */
+    if ( face->root.internal->incremental_interface )
+      return FALSE;
+#endif
+
+    /* a limit of zero disables the cache, even if it has entries */
+    return FT_BOOL( driver->charstring_cache_size );
+  }
+
+
+  /* drop all cached glyphs if the normalized design coordinates */
+  /* have changed since the cache was filled                     */
+  static void
+  cff_sync_charstring_cache( TT_Face  face )
+  {
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    FT_Memory  memory = face->root.memory;
+    CFF_Font   cff    = (CFF_Font)face->extra.data;
+    FT_Error   error;
+
+    CFF_CharstringCache      cache;
+    FT_Service_MultiMasters  mm = (FT_Service_MultiMasters)face->mm;
+
+    FT_UInt    num_coords = 0;
+    FT_Fixed*  coords     = NULL;
+    FT_UInt    i;
+
+
+    if ( !FT_HAS_MULTIPLE_MASTERS( FT_FACE( face ) ) ||
+         !mm || !mm->get_var_blend                    )
+      return;
+
+    cache = (CFF_CharstringCache)cff->charstring_cache;
+
+    mm->get_var_blend( FT_FACE( face ), &num_coords, NULL, &coords, NULL );
+    if ( !coords )
+      num_coords = 0;
+
+    if ( num_coords == cache->num_coords                          &&
+         ( !num_coords                                          ||
+           !ft_memcmp( coords, cache->coords,
+                       num_coords * sizeof ( FT_Fixed ) ) )     )
+      return;
+
+    FT_TRACE4(( "cff_sync_charstring_cache:"
+                " design coordinates changed, flushing cache\n" ));
+
+    for ( i = 0; i < cff->num_glyphs; i++ )
+      FT_FREE( cache->glyphs[i] );
+
+    cache->num_bytes = sizeof ( CFF_CharstringCacheRec ) +
+                       cff->num_glyphs * sizeof ( CFF_CachedGlyph );
+
+    if ( num_coords != cache->num_coords )
+    {
+      if ( FT_QRENEW_ARRAY( cache->coords, cache->num_coords, num_coords ) )
+      {
+        cff_face_done_charstring_cache( face );
+        return;
+      }
+
+      cache->num_coords = num_coords;
+    }
+
+    FT_ARRAY_COPY( cache->coords, coords, num_coords );
+#else
+    FT_UNUSED( face );
+#endif
+  }
+
+
+  /* get a cached glyph */
+  static CFF_CachedGlyph
+  cff_get_cached_glyph( TT_Face  face,
+                        FT_UInt  glyph_index )
+  {
+    CFF_Font  cff = (CFF_Font)face->extra.data;
+
+
+    if ( !cff->charstring_cache || glyph_index >= cff->num_glyphs )
+      return NULL;
+
+    cff_sync_charstring_cache( face );
+
+    /* the cache might have been freed */
+    if ( !cff->charstring_cache )
+      return NULL;
+
+    return ( (CFF_CharstringCache)cff->charstring_cache )
+             ->glyphs[glyph_index];
+  }
+
+
+  /* copy a cached glyph to the glyph loader, */
+  /* replacing the charstring interpreter     */
+  static FT_Error
+  cff_load_cached_glyph( CFF_Decoder*     decoder,
+                         CFF_CachedGlyph  cached )
+  {
+    FT_Error        error;
+    FT_GlyphLoader  loader  = decoder->builder.loader;
+    FT_Outline*     outline = &loader->current.outline;
+
+
+    error = FT_GLYPHLOADER_CHECK_POINTS( loader,
+                                         cached->n_points,
+                                         cached->n_contours );
+    if ( error )
+      return error;
+
+    FT_ARRAY_COPY( outline->points, cached->points, cached->n_points );
+    FT_ARRAY_COPY( outline->tags, cached->tags, cached->n_points );
+    FT_ARRAY_COPY( outline->contours, cached->contours, cached->n_contours );
+
+    outline->n_points   = cached->n_points;
+    outline->n_contours = cached->n_contours;
+
+    FT_GlyphLoader_Add( loader );
+
+    decoder->glyph_width = cached->glyph_width;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* store the glyph just produced by the charstring interpreter */
+  /* if the memory limit allows; errors are ignored              */
+  static void
+  cff_add_cached_glyph( TT_Face       face,
+                        CFF_Decoder*  decoder,
+                        FT_UInt       glyph_index,
+                        FT_ULong      charstring_len )
+  {
+    FT_Memory    memory  = face->root.memory;
+    CFF_Font     cff     = (CFF_Font)face->extra.data;
+    PS_Driver    driver  = (PS_Driver)FT_FACE_DRIVER( face );
+    FT_Outline*  outline = &decoder->builder.loader->base.outline;
+    FT_Error     error;
+
+    CFF_CharstringCache  cache = (CFF_CharstringCache)cff->charstring_cache;
+    CFF_CachedGlyph      cached;
+    FT_ULong             size;
+
+
+    if ( glyph_index >= cff->num_glyphs )
+      return;
+
+    if ( !cache )
+    {
+      size = sizeof ( CFF_CharstringCacheRec ) +
+             cff->num_glyphs * sizeof ( CFF_CachedGlyph );
+      if ( size > driver->charstring_cache_size )
+        return;
+
+      if ( FT_NEW( cache ) )
+        return;
+
+      if ( FT_NEW_ARRAY( cache->glyphs, cff->num_glyphs ) )
+      {
+        FT_FREE( cache );
+        return;
+      }
+
+      cache->num_bytes      = size;
+      cff->charstring_cache = cache;
+
+      /* record the current design coordinates */
+      cff_sync_charstring_cache( face );
+
+      cache = (CFF_CharstringCache)cff->charstring_cache;
+      if ( !cache )
+        return;
+    }
+
+    size = sizeof ( CFF_CachedGlyphRec )                             +
+           (FT_ULong)outline->n_points * ( sizeof ( FT_Vector ) + 1 ) +
+           (FT_ULong)outline->n_contours * sizeof ( FT_UShort );
+
+    if ( cache->num_bytes + size > driver->charstring_cache_size ||
+         cache->glyphs[glyph_index]                              )
+      return;
+
+    if ( FT_QALLOC( cached, size ) )
+      return;
+
+    cached->glyph_width    = decoder->glyph_width;
+    cached->charstring_len = charstring_len;
+    cached->n_contours     = outline->n_contours;
+    cached->n_points       = outline->n_points;
+
+    cached->points   = (FT_Vector*)( cached + 1 );
+    cached->contours = (FT_UShort*)( cached->points + outline->n_points );
+    cached->tags     = (FT_Byte*)( cached->contours + outline->n_contours );
+
+    FT_ARRAY_COPY( cached->points, outline->points, outline->n_points );
+    FT_ARRAY_COPY( cached->contours, outline->contours, outline->n_contours );
+    FT_ARRAY_COPY( cached->tags, outline->tags, outline->n_points );
+
+    cache->glyphs[glyph_index] = cached;
+    cache->num_bytes          += size;
+  }
+
+
   FT_LOCAL_DEF( FT_Error )
   cff_slot_load( CFF_GlyphSlot  glyph,
                  CFF_Size       size,
@@ -469,6 +757,9 @@
       FT_Byte*  charstring;
       FT_ULong  charstring_len;
 
+      FT_Bool          use_cache;
+      CFF_CachedGlyph  cached = NULL;
+
 
       decoder_funcs->init( &decoder, face, size, glyph, hinting,
                            FT_LOAD_TARGET_MODE( load_flags ),
@@ -487,6 +778,20 @@
       if ( error )
         goto Glyph_Build_Finished;
 
+      use_cache = cff_use_charstring_cache( face, load_flags );
+      if ( use_cache )
+        cached = cff_get_cached_glyph( face, glyph_index );
+
+      if ( cached )
+      {
+        error = cff_load_cached_glyph( &decoder, cached );
+        if ( error )
+          goto Glyph_Build_Finished;
+
+        charstring_len = cached->charstring_len;
+        goto Glyph_Loaded;
+      }
+
       /* now load the unscaled outline */
       error = cff_get_glyph_data( face, glyph_index,
                                   &charstring, &charstring_len );
@@ -531,6 +836,10 @@
       if ( error )
         goto Glyph_Build_Finished;
 
+      if ( use_cache )
+        cff_add_cached_glyph( face, &decoder, glyph_index, charstring_len );
+
+  Glyph_Loaded:
 #ifdef FT_CONFIG_OPTION_INCREMENTAL
       /* Control data and length may not be available for incremental */
       /* fonts.                                                       */
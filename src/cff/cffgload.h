@@ -26,6 +26,57 @@
 
 FT_BEGIN_HEADER
 
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   CFF_CachedGlyphRec
+   *
+   * @Description:
+   *   The unhinted outline of a glyph at unity scale as produced by the
+   *   charstring interpreter, together with its advance width from the
+   *   charstring.  The arrays directly follow the structure in memory.
+   */
+  typedef struct  CFF_CachedGlyphRec_
+  {
+    FT_Pos      glyph_width;
+    FT_ULong    charstring_len;
+    FT_UShort   n_contours;
+    FT_UShort   n_points;
+
+    FT_Vector*  points;
+    FT_UShort*  contours;
+    FT_Byte*    tags;
+
+  } CFF_CachedGlyphRec, *CFF_CachedGlyph;
+
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   CFF_CharstringCacheRec
+   *
+   * @Description:
+   *   A per-face cache of interpreted charstrings, used for unhinted
+   *   loading.  Its size is limited by the driver's
+   *   `charstring-cache-size` property; no entries are added once the
+   *   limit is reached.  For variation fonts, the cache is only valid for
+   *   the normalized design coordinates stored in `coords`.
+   */
+  typedef struct  CFF_CharstringCacheRec_
+  {
+    FT_ULong          num_bytes;   /* including the `glyphs' array */
+    CFF_CachedGlyph*  glyphs;      /* indexed by glyph index        */
+
+    FT_UInt           num_coords;
+    FT_Fixed*         coords;
+
+  } CFF_CharstringCacheRec, *CFF_CharstringCache;
+
+
+  FT_LOCAL( void )
+  cff_face_done_charstring_cache( TT_Face  face );
+
   FT_LOCAL( FT_Error )
   cff_get_glyph_data( TT_Face    face,
                       FT_UInt    glyph_index,
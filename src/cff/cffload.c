@@ -691,12 +691,83 @@
   CFF_Done_FD_Select( CFF_FDSelect  fdselect,
                       FT_Stream     stream )
   {
+    FT_Memory  memory = stream->memory;
+
+
     if ( fdselect->data )
       FT_FRAME_RELEASE( fdselect->data );
 
+    FT_FREE( fdselect->fds );
+
     fdselect->data_size   = 0;
     fdselect->format      = 0;
     fdselect->range_count = 0;
+    fdselect->num_fds     = 0;
+  }
+
+
+  /* Expand the ranges of a format 3 FDSelect table to an array of FD   */
+  /* indices, one byte per glyph.  Since glyph indices in format 3 are  */
+  /* 16-bit values, the array never exceeds 64KByte.  Glyphs that are   */
+  /* not covered by any range get FD index 0, as in the original range  */
+  /* scan (which we emulate exactly, even for unsorted ranges).         */
+  static FT_Error
+  cff_fd_select_expand( CFF_FDSelect  fdselect,
+                        FT_UInt       num_glyphs,
+                        FT_Memory     memory )
+  {
+    FT_Error  error;
+    FT_Byte*  p       = fdselect->data;
+    FT_Byte*  p_limit = p + fdselect->data_size - 2;
+    FT_UInt   low, limit, num_fds;
+
+
+    /* find the array size first */
+    num_fds = 0;
+    for ( p += 3; p <= p_limit; p += 3 )
+    {
+      limit = FT_PEEK_USHORT( p );
+      if ( limit > num_fds )
+        num_fds = limit;
+    }
+
+    if ( num_fds > num_glyphs )
+      num_fds = num_glyphs;
+
+    if ( !num_fds )
+      return FT_Err_Ok;
+
+    /* zero-initialized for glyphs without range */
+    if ( FT_NEW_ARRAY( fdselect->fds, num_fds ) )
+      return error;
+
+    fdselect->num_fds = num_fds;
+
+    /* A glyph is assigned to the first range whose limit is larger,   */
+    /* provided that it isn't smaller than the first range's start.   */
+    /* Glyphs below the running maximum of the limits have thus been  */
+    /* assigned already.                                              */
+    p   = fdselect->data;
+    low = FT_NEXT_USHORT( p );
+
+    while ( p < p_limit )
+    {
+      FT_Byte  fd = *p++;
+      FT_UInt  gindex;
+
+
+      limit = FT_NEXT_USHORT( p );
+      if ( limit > num_fds )
+        limit = num_fds;
+
+      for ( gindex = low; gindex < limit; gindex++ )
+        fdselect->fds[gindex] = fd;
+
+      if ( limit > low )
+        low = limit;
+    }
+
+    return FT_Err_Ok;
   }
 
 
@@ -715,8 +786,7 @@
     if ( FT_STREAM_SEEK( offset ) || FT_READ_BYTE( format ) )
       goto Exit;
 
-    fdselect->format      = format;
-    fdselect->cache_count = 0;   /* clear cache */
+    fdselect->format = format;
 
     switch ( format )
     {
@@ -740,6 +810,9 @@
     Load_Data:
       if ( FT_FRAME_EXTRACT( fdselect->data_size, fdselect->data ) )
         goto Exit;
+
+      if ( format == 3 )
+        error = cff_fd_select_expand( fdselect, num_glyphs, stream->memory );
       break;
 
     default:    /* hmm... that's wrong */
@@ -770,44 +843,8 @@
       break;
 
     case 3:
-      /* first, compare to the cache */
-      if ( glyph_index - fdselect->cache_first < fdselect->cache_count )
-      {
-        fd = fdselect->cache_fd;
-        break;
-      }
-
-      /* then, look up the ranges array */
-      {
-        FT_Byte*  p       = fdselect->data;
-        FT_Byte*  p_limit = p + fdselect->data_size;
-        FT_Byte   fd2;
-        FT_UInt   first, limit;
-
-
-        first = FT_NEXT_USHORT( p );
-        do
-        {
-          if ( glyph_index < first )
-            break;
-
-          fd2   = *p++;
-          limit = FT_NEXT_USHORT( p );
-
-          if ( glyph_index < limit )
-          {
-            fd = fd2;
-
-            /* update cache */
-            fdselect->cache_first = first;
-            fdselect->cache_count = limit - first;
-            fdselect->cache_fd    = fd2;
-            break;
-          }
-          first = limit;
-
-        } while ( p < p_limit );
-      }
+      if ( glyph_index < fdselect->num_fds )
+        fd = fdselect->fds[glyph_index];
       break;
 
     default:
@@ -35,6 +35,7 @@
 #include "cffobjs.h"
 #include "cffload.h"
 #include "cffcmap.h"
+#include "cffgload.h"
 
 #include "cfferrs.h"
 
@@ -1115,6 +1116,7 @@
 
       if ( cff )
       {
+        cff_face_done_charstring_cache( face );
         cff_font_done( cff );
         FT_FREE( face->extra.data );
       }
@@ -1161,6 +1163,8 @@
     else if ( driver->random_seed == 0 )
       driver->random_seed = 123456789;
 
+    driver->charstring_cache_size = 0;
+
     return FT_Err_Ok;
   }
 
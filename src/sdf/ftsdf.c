@@ -158,6 +158,14 @@
    */
 #define CORNER_CHECK_EPSILON  32
 
+  /*
+   * The safety margin (in 16.16 fractional units) added to the distance
+   * limit before an edge gets skipped because its control box is too far
+   * away from a pixel; it covers the rounding errors of the distance
+   * computation.
+   */
+#define PRUNE_EPSILON  1024
+
 #if 0
   /*
    * Coarse grid dimension.  Will probably be removed in the future because
@@ -445,6 +453,10 @@
    *     that behaviour.  For example, while generating SDF for a single
    *     counter-clockwise contour, the outside sign should be 1.
    *
+   *   task_runner ::
+   *     The client interface to split the computation into tasks that can
+   *     be executed concurrently; see @FT_Prop_SDF_TaskRunner.
+   *
    */
   typedef struct SDF_Params_
   {
@@ -454,6 +466,8 @@
 
     FT_Int  overload_sign;
 
+    FT_Prop_SDF_TaskRunner  task_runner;
+
   } SDF_Params;
 
 
@@ -3168,31 +3182,22 @@
 #endif /* 0 */
 
 
+  /* the minimum number of rows computed by a single task */
+#define SDF_MIN_TASK_ROWS  8
+
+
   /**************************************************************************
    *
-   * @Function:
-   *   sdf_generate_bounding_box
+   * @Struct:
+   *   SDF_BBox_Tasks
    *
    * @Description:
-   *   This function does basically the same thing as `sdf_generate` above
-   *   but more efficiently.
-   *
-   *   Instead of checking all pixels against all edges, we loop over all
-   *   edges and only check pixels around the control box of the edge; the
-   *   control box is increased by the spread in all directions.  Anything
-   *   outside of the control box that exceeds `spread` doesn't need to be
-   *   computed.
+   *   Data shared by all tasks of `sdf_generate_bounding_box`.  Each task
+   *   handles a band of `band_rows` consecutive rows of the output bitmap.
    *
-   *   Lastly, to determine the sign of unchecked pixels, we do a single
-   *   pass of all rows starting with a '+' sign and flipping when we come
-   *   across a '-' sign and continue.  This also eliminates the possibility
-   *   of overflow because we only check the proximity of the curve.
-   *   Therefore we can use squared distanced safely.
-   *
-   * @Input:
+   * @Fields:
    *   internal_params ::
    *     Internal parameters and properties required by the rasterizer.
-   *     See @SDF_Params for more.
    *
    *   shape ::
    *     A complete shape which is used to generate SDF.
@@ -3200,87 +3205,104 @@
    *   spread ::
    *     Maximum distances to be allowed in the output bitmap.
    *
-   * @Output:
-   *   bitmap ::
-   *     The output bitmap which will contain the SDF information.
+   *   width ::
+   *     The width of the output bitmap.
    *
-   * @Return:
-   *   FreeType error, 0 means success.
+   *   rows ::
+   *     The number of rows of the output bitmap.
+   *
+   *   band_rows ::
+   *     The number of rows handled by a single task.
+   *
+   *   buffer ::
+   *     The output bitmap buffer.
+   *
+   *   dists ::
+   *     The intermediate distances, one per pixel of the output bitmap.
+   *
+   *   errors ::
+   *     The error codes of all tasks.
    *
    */
-  static FT_Error
-  sdf_generate_bounding_box( const SDF_Params  internal_params,
-                             const SDF_Shape*  shape,
-                             FT_UInt           spread,
-                             const FT_Bitmap*  bitmap )
+  typedef struct  SDF_BBox_Tasks_
   {
-    FT_Error   error  = FT_Err_Ok;
-    FT_Memory  memory = NULL;
+    const SDF_Params*     internal_params;
+    const SDF_Shape*      shape;
+    FT_UInt               spread;
+    FT_Int                width;
+    FT_Int                rows;
+    FT_Int                band_rows;
 
-    FT_Int  width, rows, i, j;
-    FT_Int  sp_sq;            /* max value to check   */
+    FT_SDFFormat*         buffer;
+    SDF_Signed_Distance*  dists;
+    FT_Error*             errors;
 
-    SDF_Contour*   contours;  /* list of all contours */
-    FT_SDFFormat*  buffer;    /* the bitmap buffer    */
+  } SDF_BBox_Tasks;
 
-    /* This buffer has the same size in indices as the    */
-    /* bitmap buffer.  When we check a pixel position for */
-    /* a shortest distance we keep it in this buffer.     */
-    /* This way we can find out which pixel is set,       */
-    /* and also determine the signs properly.             */
-    SDF_Signed_Distance*  dists = NULL;
 
-    const FT_16D16  fixed_spread = (FT_16D16)FT_INT_16D16( spread );
+  /**************************************************************************
+   *
+   * @Function:
+   *   sdf_bounding_box_task
+   *
+   * @Description:
+   *   Compute the SDF of a band of rows of the output bitmap as described
+   *   in `sdf_generate_bounding_box`.  Every band loops over all edges in
+   *   the same order and ignores the pixels outside of the band; this
+   *   makes the result independent of the number of bands.
+   *
+   * @Input:
+   *   task_data ::
+   *     A pointer to @SDF_BBox_Tasks.
+   *
+   *   task_index ::
+   *     The index of the band to compute.
+   *
+   */
+  static void
+  sdf_bounding_box_task( FT_Pointer  task_data,
+                         FT_UInt     task_index )
+  {
+    SDF_BBox_Tasks*  tasks = (SDF_BBox_Tasks*)task_data;
 
+    const SDF_Params*  internal_params = tasks->internal_params;
 
-    if ( !shape || !bitmap )
-    {
-      error = FT_THROW( Invalid_Argument );
-      goto Exit;
-    }
+    FT_Error  error = FT_Err_Ok;
 
-    if ( spread < MIN_SPREAD || spread > MAX_SPREAD )
-    {
-      error = FT_THROW( Invalid_Argument );
-      goto Exit;
-    }
+    FT_Int  width = tasks->width;
+    FT_Int  rows  = tasks->rows;
+    FT_Int  i, j;
+    FT_Int  y_min, y_max;     /* the band in shape coordinates   */
+    FT_Int  row_min, row_max; /* the band in bitmap coordinates  */
+    FT_Int  sp_sq;            /* max value to check              */
 
-    memory = shape->memory;
-    if ( !memory )
+    SDF_Contour*          contours = tasks->shape->contours;
+    FT_SDFFormat*         buffer   = tasks->buffer;
+    SDF_Signed_Distance*  dists    = tasks->dists;
+
+    const FT_UInt   spread       = tasks->spread;
+    const FT_16D16  fixed_spread = (FT_16D16)FT_INT_16D16( spread );
+
+
+    y_min = (FT_Int)task_index * tasks->band_rows;
+    y_max = FT_MIN( y_min + tasks->band_rows, rows );
+
+    if ( internal_params->flip_y )
     {
-      error = FT_THROW( Invalid_Argument );
-      goto Exit;
+      row_min = y_min;
+      row_max = y_max;
     }
-
-    if ( bitmap->rows > FT_INT_MAX / bitmap->width )
+    else
     {
-      error = FT_THROW( Array_Too_Large );
-      goto Exit;
+      row_min = rows - y_max;
+      row_max = rows - y_min;
     }
-    if ( FT_NEW_ARRAY( dists, bitmap->rows * bitmap->width ) )
-      goto Exit;
-
-    contours = shape->contours;
-    width    = (FT_Int)bitmap->width;
-    rows     = (FT_Int)bitmap->rows;
-    buffer   = (FT_SDFFormat*)bitmap->buffer;
 
     if ( USE_SQUARED_DISTANCES )
       sp_sq = FT_INT_16D16( (FT_Int)( spread * spread ) );
     else
       sp_sq = fixed_spread;
 
-    if ( width == 0 || rows == 0 )
-    {
-      FT_TRACE0(( "sdf_generate:"
-                  " Cannot render glyph with width/height == 0\n" ));
-      FT_TRACE0(( "             "
-                  " (width, height provided [%d, %d])", width, rows ));
-
-      error = FT_THROW( Cannot_Render_Glyph );
-      goto Exit;
-    }
-
     /* loop over all contours */
     while ( contours )
     {
@@ -3290,18 +3312,31 @@
       /* loop over all edges */
       while ( edges )
       {
+        FT_CBox  bbox;
         FT_CBox  cbox;
         FT_Int   x, y;
+        FT_Bool  prune;
 
 
         /* get the control box and increase it by `spread' */
-        cbox = get_control_box( *edges );
+        bbox = get_control_box( *edges );
+        cbox = bbox;
 
         cbox.xMin = ( cbox.xMin - 63 ) / 64 - ( FT_Pos )spread;
         cbox.xMax = ( cbox.xMax + 63 ) / 64 + ( FT_Pos )spread;
         cbox.yMin = ( cbox.yMin - 63 ) / 64 - ( FT_Pos )spread;
         cbox.yMax = ( cbox.yMax + 63 ) / 64 + ( FT_Pos )spread;
 
+        /* The distance to a line segment is exact up to rounding; */
+        /* curves use approximations, so they are never skipped.   */
+        prune = FT_BOOL( edges->edge_type == SDF_EDGE_LINE );
+
+        /* only handle the rows of the current band */
+        if ( cbox.yMin < y_min )
+          cbox.yMin = y_min;
+        if ( cbox.yMax > y_max )
+          cbox.yMax = y_max;
+
         /* now loop over the pixels in the control box. */
         for ( y = cbox.yMin; y < cbox.yMax; y++ )
         {
@@ -3315,8 +3350,6 @@
 
             if ( x < 0 || x >= width )
               continue;
-            if ( y < 0 || y >= rows )
-              continue;
 
             grid_point.x = FT_INT_26D6( x );
             grid_point.y = FT_INT_26D6( y );
@@ -3326,11 +3359,50 @@
             grid_point.x += FT_INT_26D6( 1 ) / 2;
             grid_point.y += FT_INT_26D6( 1 ) / 2;
 
+            if ( internal_params->flip_y )
+              index = (FT_UInt)( y * width + x );
+            else
+              index = (FT_UInt)( ( rows - y - 1 ) * width + x );
+
+            /*
+             * The edge can only modify the pixel if its distance is at
+             * most `spread` and, for an already set pixel, if it is not
+             * larger than the current distance plus the corner epsilon.
+             * The distance to the control box is a cheap lower bound of
+             * the distance to the edge; use it to skip the much more
+             * expensive distance computation whenever possible.  The
+             * output doesn't change.
+             */
+            if ( prune )
+            {
+              FT_Pos    dx, dy, lower;
+              FT_16D16  limit = fixed_spread;
+
+
+              dx = FT_MAX( bbox.xMin - grid_point.x,
+                           grid_point.x - bbox.xMax );
+              dy = FT_MAX( bbox.yMin - grid_point.y,
+                           grid_point.y - bbox.yMax );
+              dx = FT_MAX( dx, 0 );
+              dy = FT_MAX( dy, 0 );
+
+              /* both `max(dx,dy)` and `(dx+dy)/sqrt(2)` */
+              /* are lower bounds of `|(dx,dy)|`          */
+              lower = FT_MAX( FT_MAX( dx, dy ), ( dx + dy ) * 181 / 256 );
+
+              if ( dists[index].sign != 0                                 &&
+                   dists[index].distance + CORNER_CHECK_EPSILON < limit )
+                limit = dists[index].distance + CORNER_CHECK_EPSILON;
+
+              if ( FT_26D6_16D16( lower ) > limit + PRUNE_EPSILON )
+                continue;
+            }
+
             FT_CALL( sdf_edge_get_min_distance( edges,
                                                 grid_point,
                                                 &dist ) );
 
-            if ( internal_params.orientation == FT_ORIENTATION_FILL_LEFT )
+            if ( internal_params->orientation == FT_ORIENTATION_FILL_LEFT )
               dist.sign = -dist.sign;
 
             /* ignore if the distance is greater than spread;       */
@@ -3342,11 +3414,6 @@
             if ( USE_SQUARED_DISTANCES )
               dist.distance = square_root( dist.distance );
 
-            if ( internal_params.flip_y )
-              index = (FT_UInt)( y * width + x );
-            else
-              index = (FT_UInt)( ( rows - y - 1 ) * width + x );
-
             /* check whether the pixel is set or not */
             if ( dists[index].sign == 0 )
               dists[index] = dist;
@@ -3369,15 +3436,15 @@
     }
 
     /* final pass */
-    for ( j = 0; j < rows; j++ )
+    for ( j = row_min; j < row_max; j++ )
     {
       /* We assume the starting pixel of each row is outside. */
       FT_Char  current_sign = -1;
       FT_UInt  index;
 
 
-      if ( internal_params.overload_sign != 0 )
-        current_sign = internal_params.overload_sign < 0 ? -1 : 1;
+      if ( internal_params->overload_sign != 0 )
+        current_sign = internal_params->overload_sign < 0 ? -1 : 1;
 
       for ( i = 0; i < width; i++ )
       {
@@ -3395,8 +3462,8 @@
           dists[index].distance = fixed_spread;
 
         /* flip sign if required */
-        dists[index].distance *= internal_params.flip_sign ? -current_sign
-                                                           :  current_sign;
+        dists[index].distance *= internal_params->flip_sign ? -current_sign
+                                                            :  current_sign;
 
         /* concatenate to appropriate format */
         buffer[index] = map_fixed_to_sdf( dists[index].distance,
@@ -3405,6 +3472,165 @@
     }
 
   Exit:
+    tasks->errors[task_index] = error;
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   sdf_generate_bounding_box
+   *
+   * @Description:
+   *   This function does basically the same thing as `sdf_generate` above
+   *   but more efficiently.
+   *
+   *   Instead of checking all pixels against all edges, we loop over all
+   *   edges and only check pixels around the control box of the edge; the
+   *   control box is increased by the spread in all directions.  Anything
+   *   outside of the control box that exceeds `spread` doesn't need to be
+   *   computed.
+   *
+   *   Lastly, to determine the sign of unchecked pixels, we do a single
+   *   pass of all rows starting with a '+' sign and flipping when we come
+   *   across a '-' sign and continue.  This also eliminates the possibility
+   *   of overflow because we only check the proximity of the curve.
+   *   Therefore we can use squared distanced safely.
+   *
+   *   If the client has set up a task runner, the bitmap is split into
+   *   bands of rows that are computed by independent tasks (see
+   *   `sdf_bounding_box_task`); the output does not depend on the number
+   *   of bands.
+   *
+   * @Input:
+   *   internal_params ::
+   *     Internal parameters and properties required by the rasterizer.
+   *     See @SDF_Params for more.
+   *
+   *   shape ::
+   *     A complete shape which is used to generate SDF.
+   *
+   *   spread ::
+   *     Maximum distances to be allowed in the output bitmap.
+   *
+   * @Output:
+   *   bitmap ::
+   *     The output bitmap which will contain the SDF information.
+   *
+   * @Return:
+   *   FreeType error, 0 means success.
+   *
+   */
+  static FT_Error
+  sdf_generate_bounding_box( const SDF_Params  internal_params,
+                             const SDF_Shape*  shape,
+                             FT_UInt           spread,
+                             const FT_Bitmap*  bitmap )
+  {
+    FT_Error   error  = FT_Err_Ok;
+    FT_Memory  memory = NULL;
+
+    FT_Int   width, rows;
+    FT_UInt  num_tasks, n;
+
+    SDF_BBox_Tasks  tasks;
+
+    /* This buffer has the same size in indices as the    */
+    /* bitmap buffer.  When we check a pixel position for */
+    /* a shortest distance we keep it in this buffer.     */
+    /* This way we can find out which pixel is set,       */
+    /* and also determine the signs properly.             */
+    SDF_Signed_Distance*  dists = NULL;
+
+    FT_Error*  errors = NULL;
+
+
+    if ( !shape || !bitmap )
+    {
+      error = FT_THROW( Invalid_Argument );
+      goto Exit;
+    }
+
+    if ( spread < MIN_SPREAD || spread > MAX_SPREAD )
+    {
+      error = FT_THROW( Invalid_Argument );
+      goto Exit;
+    }
+
+    memory = shape->memory;
+    if ( !memory )
+    {
+      error = FT_THROW( Invalid_Argument );
+      goto Exit;
+    }
+
+    if ( bitmap->rows > FT_INT_MAX / bitmap->width )
+    {
+      error = FT_THROW( Array_Too_Large );
+      goto Exit;
+    }
+    if ( FT_NEW_ARRAY( dists, bitmap->rows * bitmap->width ) )
+      goto Exit;
+
+    width = (FT_Int)bitmap->width;
+    rows  = (FT_Int)bitmap->rows;
+
+    if ( width == 0 || rows == 0 )
+    {
+      FT_TRACE0(( "sdf_generate:"
+                  " Cannot render glyph with width/height == 0\n" ));
+      FT_TRACE0(( "             "
+                  " (width, height provided [%d, %d])", width, rows ));
+
+      error = FT_THROW( Cannot_Render_Glyph );
+      goto Exit;
+    }
+
+    /* split the bitmap into bands of at least `SDF_MIN_TASK_ROWS` rows */
+    num_tasks = 1;
+    if ( internal_params.task_runner.run_tasks )
+    {
+      num_tasks = internal_params.task_runner.num_tasks;
+      if ( num_tasks > (FT_UInt)rows / SDF_MIN_TASK_ROWS )
+        num_tasks = (FT_UInt)rows / SDF_MIN_TASK_ROWS;
+      if ( num_tasks < 1 )
+        num_tasks = 1;
+    }
+
+    tasks.band_rows = ( rows + (FT_Int)num_tasks - 1 ) / (FT_Int)num_tasks;
+    num_tasks       = (FT_UInt)( ( rows + tasks.band_rows - 1 ) /
+                                 tasks.band_rows );
+
+    if ( FT_QNEW_ARRAY( errors, num_tasks ) )
+      goto Exit;
+
+    tasks.internal_params = &internal_params;
+    tasks.shape           = shape;
+    tasks.spread          = spread;
+    tasks.width           = width;
+    tasks.rows            = rows;
+    tasks.buffer          = (FT_SDFFormat*)bitmap->buffer;
+    tasks.dists           = dists;
+    tasks.errors          = errors;
+
+    if ( num_tasks == 1 )
+      sdf_bounding_box_task( &tasks, 0 );
+    else
+      internal_params.task_runner.run_tasks(
+        sdf_bounding_box_task,
+        &tasks,
+        num_tasks,
+        internal_params.task_runner.runner_data );
+
+    for ( n = 0; n < num_tasks; n++ )
+    {
+      error = errors[n];
+      if ( error )
+        break;
+    }
+
+  Exit:
+    FT_FREE( errors );
     FT_FREE( dists );
     return error;
   }
@@ -3859,6 +4085,7 @@
     internal_params.flip_sign     = sdf_params->flip_sign;
     internal_params.flip_y        = sdf_params->flip_y;
     internal_params.overload_sign = 0;
+    internal_params.task_runner   = sdf_params->task_runner;
 
     FT_CALL( sdf_shape_new( memory, &shape ) );
 
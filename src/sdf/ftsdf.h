@@ -24,6 +24,7 @@
 #include <ft2build.h>
 #include FT_CONFIG_CONFIG_H
 #include <freetype/ftimage.h>
+#include <freetype/ftdriver.h>
 
 /* common properties and function */
 #include "ftsdfcommon.h"
@@ -67,18 +68,25 @@ FT_BEGIN_HEADER
    *     considerable amount of extra memory; additionally, it will not work
    *     if generating SDF from bitmap.
    *
+   *   task_runner ::
+   *     The client interface to execute parts of the SDF computation
+   *     concurrently.  If its `run_tasks` field is `NULL`, everything is
+   *     computed by the calling thread.
+   *
    * @note:
    *   All properties are valid for both the 'sdf' and 'bsdf' renderers; the
-   *   exception is `overlaps`, which gets ignored by the 'bsdf' renderer.
+   *   exceptions are `overlaps` and `task_runner`, which get ignored by the
+   *   'bsdf' renderer.
    *
    */
   typedef struct  SDF_Raster_Params_
   {
-    FT_Raster_Params  root;
-    FT_UInt           spread;
-    FT_Bool           flip_sign;
-    FT_Bool           flip_y;
-    FT_Bool           overlaps;
+    FT_Raster_Params        root;
+    FT_UInt                 spread;
+    FT_Bool                 flip_sign;
+    FT_Bool                 flip_y;
+    FT_Bool                 overlaps;
+    FT_Prop_SDF_TaskRunner  task_runner;
 
   } SDF_Raster_Params;
 
@@ -118,6 +118,24 @@
                   " updated property `overlaps' to %d\n", val ));
     }
 
+    else if ( ft_strcmp( property_name, "task_runner" ) == 0 )
+    {
+      const FT_Prop_SDF_TaskRunner*  runner =
+                                       (const FT_Prop_SDF_TaskRunner*)value;
+
+
+      if ( value_is_string )
+      {
+        error = FT_THROW( Invalid_Argument );
+        goto Exit;
+      }
+
+      render->task_runner = *runner;
+      FT_TRACE7(( "[sdf] sdf_property_set:"
+                  " updated property `task_runner' (%u tasks)\n",
+                  runner->num_tasks ));
+    }
+
     else
     {
       FT_TRACE0(( "[sdf] sdf_property_set:"
@@ -172,6 +190,14 @@
       *val = render->overlaps;
     }
 
+    else if ( ft_strcmp( property_name, "task_runner" ) == 0 )
+    {
+      FT_Prop_SDF_TaskRunner*  val = (FT_Prop_SDF_TaskRunner*)value;
+
+
+      *val = render->task_runner;
+    }
+
     else
     {
       FT_TRACE0(( "[sdf] sdf_property_get:"
@@ -231,6 +257,10 @@
     sdf_render->flip_y    = 0;
     sdf_render->overlaps  = 0;
 
+    sdf_render->task_runner.run_tasks   = NULL;
+    sdf_render->task_runner.runner_data = NULL;
+    sdf_render->task_runner.num_tasks   = 0;
+
     return FT_Err_Ok;
   }
 
@@ -346,6 +376,7 @@
     params.flip_sign   = sdf_module->flip_sign;
     params.flip_y      = sdf_module->flip_y;
     params.overlaps    = sdf_module->overlaps;
+    params.task_runner = sdf_module->task_runner;
 
     /* render the outline */
     error = render->raster_render( render->raster,
@@ -23,6 +23,7 @@
 
 #include <freetype/ftrender.h>
 #include <freetype/ftmodapi.h>
+#include <freetype/ftdriver.h>
 #include <freetype/internal/ftobjs.h>
 
 FT_BEGIN_HEADER
@@ -66,18 +67,23 @@ FT_BEGIN_HEADER
    *     considerable amount of extra memory; additionally, it will not work
    *     if generating SDF from bitmap.
    *
+   *   task_runner ::
+   *     The client interface to execute parts of the SDF computation
+   *     concurrently.  See @task_runner for more.
+   *
    * @note:
-   *   All properties except `overlaps` are valid for both the 'sdf' and
-   *   'bsdf' renderers.
+   *   All properties except `overlaps` and `task_runner` are valid for both
+   *   the 'sdf' and 'bsdf' renderers.
    *
    */
   typedef struct  SDF_Renderer_Module_
   {
-    FT_RendererRec  root;
-    FT_UInt         spread;
-    FT_Bool         flip_sign;
-    FT_Bool         flip_y;
-    FT_Bool         overlaps;
+    FT_RendererRec          root;
+    FT_UInt                 spread;
+    FT_Bool                 flip_sign;
+    FT_Bool                 flip_y;
+    FT_Bool                 overlaps;
+    FT_Prop_SDF_TaskRunner  task_runner;
 
   } SDF_Renderer_Module, *SDF_Renderer;
 
@@ -1127,7 +1127,9 @@
   FT_DEFINE_SERVICE_TTCMAPSREC(
     tt_service_get_cmap_info,
 
-    tt_get_cmap_info  /* TT_CMap_Info_GetFunc get_cmap_info */
+    tt_get_cmap_info,     /* TT_CMap_Info_GetFunc       get_cmap_info */
+    tt_get_char_indices,  /* TT_CMap_Char_Indices_Func  char_indices  */
+    tt_get_coverage       /* TT_CMap_Coverage_Func      get_coverage  */
   )
 
 
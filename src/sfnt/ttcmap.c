@@ -203,7 +203,9 @@
 
     0,
     (TT_CMap_ValidateFunc)tt_cmap0_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap0_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap0_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)NULL,  /* char_indices  */
+    (TT_CMap_Coverage_Func)NULL  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_0 */
@@ -620,7 +622,9 @@
 
     2,
     (TT_CMap_ValidateFunc)tt_cmap2_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap2_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap2_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)NULL,  /* char_indices  */
+    (TT_CMap_Coverage_Func)NULL  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_2 */
@@ -1530,6 +1534,252 @@
   }
 
 
+  /* Map a whole array of character codes.  For sorted, non-overlapping */
+  /* segments we remember the segment of the previous character code;   */
+  /* text usually stays within a script, so most look-ups hit it and    */
+  /* the binary search is only needed when the segment changes.         */
+  FT_CALLBACK_DEF( FT_UInt )
+  tt_cmap4_char_indices( FT_CharMap        charmap,    /* TT_CMap */
+                         const FT_UInt32*  char_codes,
+                         FT_UInt           count,
+                         FT_UInt*          gindices,
+                         FT_Bool           stop )
+  {
+    TT_CMap   cmap       = (TT_CMap)charmap;
+    TT_Face   face       = (TT_Face)FT_CMAP_FACE( cmap );
+    FT_Byte*  limit      = face->cmap_table + face->cmap_size;
+    FT_UInt   num_glyphs = (FT_UInt)face->root.num_glyphs;
+
+    FT_Byte*  p         = cmap->data + 6;
+    FT_UInt   num_segs  = TT_PEEK_USHORT( p ) >> 1;
+    FT_UInt   num_segs2 = num_segs << 1;
+    FT_Byte*  ends      = cmap->data + 14;
+    FT_Byte*  starts    = ends + num_segs2 + 2;
+    FT_Byte*  deltas    = starts + num_segs2;
+    FT_Byte*  offsets   = deltas + num_segs2;
+
+    /* the current segment; initially empty */
+    FT_UInt   start  = 1;
+    FT_UInt   end    = 0;
+    FT_Int    delta  = 0;
+    FT_UInt   offset = 0;
+    FT_Byte*  q      = NULL;
+
+    FT_UInt  n;
+
+
+    if ( cmap->flags )
+    {
+      for ( n = 0; n < count; n++ )
+      {
+        FT_UInt  gindex = tt_cmap4_char_index( FT_CMAP( cmap ),
+                                               char_codes[n] );
+
+
+        if ( gindex >= num_glyphs )
+          gindex = 0;
+
+        gindices[n] = gindex;
+
+        if ( stop && !gindex )
+          return n;
+      }
+
+      return count;
+    }
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_UInt32  char_code = char_codes[n];
+      FT_UInt    gindex    = 0;
+
+
+      if ( char_code < 0x10000UL )
+      {
+        if ( char_code < start || char_code > end )
+        {
+          FT_UInt  min = 0;
+          FT_UInt  max = num_segs;
+
+
+          start = 1;
+          end   = 0;
+
+          /* binary search, see `tt_cmap4_char_map_binary' */
+          while ( min < max )
+          {
+            FT_UInt  mid = ( min + max ) >> 1;
+            FT_UInt  s   = TT_PEEK_USHORT( starts + mid * 2 );
+            FT_UInt  e   = TT_PEEK_USHORT( ends + mid * 2 );
+
+
+            if ( char_code < s )
+              max = mid;
+            else if ( char_code > e )
+              min = mid + 1;
+            else
+            {
+              start  = s;
+              end    = e;
+              delta  = TT_PEEK_SHORT( deltas + mid * 2 );
+              q      = offsets + mid * 2;
+              offset = TT_PEEK_USHORT( q );
+
+              /* some fonts have an incorrect last segment; */
+              /* we have to catch it                        */
+              if ( mid >= num_segs - 1                &&
+                   start == 0xFFFFU && end == 0xFFFFU &&
+                   offset && q + offset + 2 > limit   )
+              {
+                delta  = 1;
+                offset = 0;
+              }
+              break;
+            }
+          }
+        }
+
+        if ( char_code >= start && char_code <= end && offset != 0xFFFFU )
+        {
+          if ( offset )
+          {
+            gindex = TT_PEEK_USHORT( q + offset + ( char_code - start ) * 2 );
+            if ( gindex )
+              gindex = (FT_UInt)( (FT_Int)gindex + delta ) & 0xFFFFU;
+          }
+          else
+            gindex = (FT_UInt)( (FT_Int)char_code + delta ) & 0xFFFFU;
+
+          if ( gindex >= num_glyphs )
+            gindex = 0;
+        }
+      }
+
+      gindices[n] = gindex;
+
+      if ( stop && !gindex )
+        return n;
+    }
+
+    return count;
+  }
+
+
+  /* Compute the coverage from the segments.  This gives the same result */
+  /* as `tt_cmap4_char_index', which is why we don't handle unsorted or  */
+  /* overlapping segments.                                               */
+  FT_CALLBACK_DEF( FT_Error )
+  tt_cmap4_get_coverage( FT_CharMap   charmap,    /* TT_CMap */
+                         FT_Coverage  coverage )
+  {
+    TT_CMap   cmap       = (TT_CMap)charmap;
+    TT_Face   face       = (TT_Face)FT_CMAP_FACE( cmap );
+    FT_Byte*  limit      = face->cmap_table + face->cmap_size;
+    FT_UInt   num_glyphs = (FT_UInt)face->root.num_glyphs;
+
+    FT_Byte*  p         = cmap->data + 6;
+    FT_UInt   num_segs  = TT_PEEK_USHORT( p ) >> 1;
+    FT_UInt   num_segs2 = num_segs << 1;
+    FT_Byte*  ends      = cmap->data + 14;
+    FT_Byte*  starts    = ends + num_segs2 + 2;
+    FT_Byte*  deltas    = starts + num_segs2;
+    FT_Byte*  offsets   = deltas + num_segs2;
+
+    FT_Error  error = FT_Err_Ok;
+    FT_UInt   n;
+
+
+    if ( cmap->flags )
+      return FT_THROW( Unimplemented_Feature );
+
+    if ( !num_glyphs )
+      return FT_Err_Ok;
+
+    for ( n = 0; n < num_segs; n++ )
+    {
+      FT_UInt   start  = TT_PEEK_USHORT( starts + n * 2 );
+      FT_UInt   end    = TT_PEEK_USHORT( ends + n * 2 );
+      FT_Int    delta  = TT_PEEK_SHORT( deltas + n * 2 );
+      FT_Byte*  q      = offsets + n * 2;
+      FT_UInt   offset = TT_PEEK_USHORT( q );
+      FT_UInt   code;
+
+
+      /* some fonts have an incorrect last segment; */
+      /* we have to catch it                        */
+      if ( n >= num_segs - 1                  &&
+           start == 0xFFFFU && end == 0xFFFFU &&
+           offset && q + offset + 2 > limit   )
+      {
+        delta  = 1;
+        offset = 0;
+      }
+
+      if ( offset == 0xFFFFU )
+        continue;
+
+      if ( !offset )
+      {
+        /* The glyph indices are `code + delta' modulo 0x10000; we split */
+        /* the segment where they wrap around and clip both parts to the */
+        /* range of valid glyph indices.                                 */
+        for ( code = start; code <= end; )
+        {
+          FT_UInt  gindex = (FT_UInt)( (FT_Int)code + delta ) & 0xFFFFU;
+          FT_UInt  last   = code + ( 0xFFFFU - gindex );
+          FT_UInt  min, max;
+
+
+          if ( last > end )
+            last = end;
+
+          min = gindex ? gindex : 1;
+          max = gindex + ( last - code );
+          if ( max > num_glyphs - 1 )
+            max = num_glyphs - 1;
+
+          if ( min <= max )
+          {
+            error = FT_Coverage_Add_Range( coverage,
+                                           code + ( min - gindex ),
+                                           code + ( max - gindex ) );
+            if ( error )
+              return error;
+          }
+
+          code = last + 1;
+        }
+      }
+      else
+      {
+        FT_Byte*  values = q + offset;
+
+
+        for ( code = start; code <= end; code++ )
+        {
+          FT_Byte*  v      = values + ( code - start ) * 2;
+          FT_UInt   gindex = 0;
+
+
+          if ( v + 2 <= limit )
+            gindex = TT_PEEK_USHORT( v );
+          if ( gindex )
+            gindex = (FT_UInt)( (FT_Int)gindex + delta ) & 0xFFFFU;
+
+          if ( gindex && gindex < num_glyphs )
+          {
+            error = FT_Coverage_Add_Range( coverage, code, code );
+            if ( error )
+              return error;
+          }
+        }
+      }
+    }
+
+    return error;
+  }
+
+
   FT_CALLBACK_DEF( FT_Error )
   tt_cmap4_get_info( FT_CharMap    cmap,       /* TT_CMap */
                      TT_CMapInfo  *cmap_info )
@@ -1563,7 +1813,9 @@
 
     4,
     (TT_CMap_ValidateFunc)tt_cmap4_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap4_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap4_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)tt_cmap4_char_indices,  /* char_indices  */
+    (TT_CMap_Coverage_Func)tt_cmap4_get_coverage  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_4 */
@@ -1736,7 +1988,9 @@
 
     6,
     (TT_CMap_ValidateFunc)tt_cmap6_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap6_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap6_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)NULL,  /* char_indices  */
+    (TT_CMap_Coverage_Func)NULL  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_6 */
@@ -2033,7 +2287,9 @@
 
     8,
     (TT_CMap_ValidateFunc)tt_cmap8_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap8_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap8_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)NULL,  /* char_indices  */
+    (TT_CMap_Coverage_Func)NULL  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_8 */
@@ -2208,7 +2464,9 @@
 
     10,
     (TT_CMap_ValidateFunc)tt_cmap10_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap10_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap10_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)NULL,  /* char_indices  */
+    (TT_CMap_Coverage_Func)NULL  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_10 */
@@ -2519,6 +2777,138 @@
   }
 
 
+  /* Map a whole array of character codes, remembering the group of */
+  /* the previous one; groups are sorted and disjoint (this is      */
+  /* enforced by `tt_cmap12_validate').                             */
+  FT_CALLBACK_DEF( FT_UInt )
+  tt_cmap12_char_indices( FT_CharMap        charmap,    /* TT_CMap */
+                          const FT_UInt32*  char_codes,
+                          FT_UInt           count,
+                          FT_UInt*          gindices,
+                          FT_Bool           stop )
+  {
+    TT_CMap    cmap       = (TT_CMap)charmap;
+    FT_UInt    num_glyphs = (FT_UInt)FT_CMAP_FACE( cmap )->num_glyphs;
+    FT_Byte*   p          = cmap->data + 12;
+    FT_UInt32  num_groups = TT_PEEK_ULONG( p );
+
+    /* the current group; initially empty */
+    FT_UInt32  start    = 1;
+    FT_UInt32  end      = 0;
+    FT_UInt32  start_id = 0;
+
+    FT_UInt  n;
+
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_UInt32  char_code = char_codes[n];
+      FT_UInt    gindex    = 0;
+
+
+      if ( char_code < start || char_code > end )
+      {
+        FT_UInt32  min = 0;
+        FT_UInt32  max = num_groups;
+
+
+        start = 1;
+        end   = 0;
+
+        /* binary search, see `tt_cmap12_char_map_binary' */
+        while ( min < max )
+        {
+          FT_UInt32  mid = ( min + max ) >> 1;
+          FT_UInt32  s, e;
+
+
+          p = cmap->data + 16 + 12 * mid;
+          s = TT_NEXT_ULONG( p );
+          e = TT_NEXT_ULONG( p );
+
+          if ( char_code < s )
+            max = mid;
+          else if ( char_code > e )
+            min = mid + 1;
+          else
+          {
+            start    = s;
+            end      = e;
+            start_id = TT_PEEK_ULONG( p );
+            break;
+          }
+        }
+      }
+
+      if ( char_code >= start && char_code <= end )
+      {
+        /* reject invalid glyph index */
+        if ( start_id <= 0xFFFFFFFFUL - ( char_code - start ) )
+          gindex = (FT_UInt)( start_id + ( char_code - start ) );
+
+        if ( gindex >= num_glyphs )
+          gindex = 0;
+      }
+
+      gindices[n] = gindex;
+
+      if ( stop && !gindex )
+        return n;
+    }
+
+    return count;
+  }
+
+
+  /* Compute the coverage from the groups, which are sorted. */
+  FT_CALLBACK_DEF( FT_Error )
+  tt_cmap12_get_coverage( FT_CharMap   charmap,    /* TT_CMap */
+                          FT_Coverage  coverage )
+  {
+    TT_CMap    cmap       = (TT_CMap)charmap;
+    FT_UInt32  num_glyphs = (FT_UInt32)FT_CMAP_FACE( cmap )->num_glyphs;
+    FT_Byte*   p          = cmap->data + 12;
+    FT_UInt32  num_groups = TT_NEXT_ULONG( p );
+    FT_UInt32  n;
+
+
+    for ( n = 0; n < num_groups; n++ )
+    {
+      FT_UInt32  start    = TT_NEXT_ULONG( p );
+      FT_UInt32  end      = TT_NEXT_ULONG( p );
+      FT_UInt32  start_id = TT_NEXT_ULONG( p );
+
+
+      /* glyph index `start_id + ( code - start )' must be in the */
+      /* range [1;num_glyphs-1]                                   */
+      if ( !start_id )
+      {
+        if ( start == end )
+          continue;
+
+        start++;
+        start_id++;
+      }
+
+      if ( start_id >= num_glyphs )
+        continue;
+
+      if ( end - start > num_glyphs - 1 - start_id )
+        end = start + ( num_glyphs - 1 - start_id );
+
+      {
+        FT_Error  error = FT_Coverage_Add_Range( coverage, start, end );
+
+
+        if ( error )
+          return error;
+      }
+    }
+
+    return FT_Err_Ok;
+  }
+
+
   FT_CALLBACK_DEF( FT_Error )
   tt_cmap12_get_info( FT_CharMap    cmap,       /* TT_CMap */
                       TT_CMapInfo  *cmap_info )
@@ -2552,7 +2942,9 @@
 
     12,
     (TT_CMap_ValidateFunc)tt_cmap12_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap12_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap12_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)tt_cmap12_char_indices,  /* char_indices  */
+    (TT_CMap_Coverage_Func)tt_cmap12_get_coverage  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_12 */
@@ -2835,6 +3227,120 @@
   }
 
 
+  /* Map a whole array of character codes, remembering the group of */
+  /* the previous one; groups are sorted and disjoint (this is      */
+  /* enforced by `tt_cmap13_validate').                             */
+  FT_CALLBACK_DEF( FT_UInt )
+  tt_cmap13_char_indices( FT_CharMap        charmap,    /* TT_CMap */
+                          const FT_UInt32*  char_codes,
+                          FT_UInt           count,
+                          FT_UInt*          gindices,
+                          FT_Bool           stop )
+  {
+    TT_CMap    cmap       = (TT_CMap)charmap;
+    FT_UInt    num_glyphs = (FT_UInt)FT_CMAP_FACE( cmap )->num_glyphs;
+    FT_Byte*   p          = cmap->data + 12;
+    FT_UInt32  num_groups = TT_PEEK_ULONG( p );
+
+    /* the current group; initially empty */
+    FT_UInt32  start    = 1;
+    FT_UInt32  end      = 0;
+    FT_UInt32  glyph_id = 0;
+
+    FT_UInt  n;
+
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_UInt32  char_code = char_codes[n];
+      FT_UInt    gindex    = 0;
+
+
+      if ( char_code < start || char_code > end )
+      {
+        FT_UInt32  min = 0;
+        FT_UInt32  max = num_groups;
+
+
+        start = 1;
+        end   = 0;
+
+        /* binary search, see `tt_cmap13_char_map_binary' */
+        while ( min < max )
+        {
+          FT_UInt32  mid = ( min + max ) >> 1;
+          FT_UInt32  s, e;
+
+
+          p = cmap->data + 16 + 12 * mid;
+          s = TT_NEXT_ULONG( p );
+          e = TT_NEXT_ULONG( p );
+
+          if ( char_code < s )
+            max = mid;
+          else if ( char_code > e )
+            min = mid + 1;
+          else
+          {
+            start    = s;
+            end      = e;
+            glyph_id = TT_PEEK_ULONG( p );
+            break;
+          }
+        }
+      }
+
+      if ( char_code >= start && char_code <= end )
+      {
+        gindex = (FT_UInt)glyph_id;
+
+        if ( gindex >= num_glyphs )
+          gindex = 0;
+      }
+
+      gindices[n] = gindex;
+
+      if ( stop && !gindex )
+        return n;
+    }
+
+    return count;
+  }
+
+
+  /* Compute the coverage from the groups, which are sorted. */
+  FT_CALLBACK_DEF( FT_Error )
+  tt_cmap13_get_coverage( FT_CharMap   charmap,    /* TT_CMap */
+                          FT_Coverage  coverage )
+  {
+    TT_CMap    cmap       = (TT_CMap)charmap;
+    FT_UInt32  num_glyphs = (FT_UInt32)FT_CMAP_FACE( cmap )->num_glyphs;
+    FT_Byte*   p          = cmap->data + 12;
+    FT_UInt32  num_groups = TT_NEXT_ULONG( p );
+    FT_UInt32  n;
+
+
+    for ( n = 0; n < num_groups; n++ )
+    {
+      FT_UInt32  start    = TT_NEXT_ULONG( p );
+      FT_UInt32  end      = TT_NEXT_ULONG( p );
+      FT_UInt32  glyph_id = TT_NEXT_ULONG( p );
+
+
+      if ( glyph_id && glyph_id < num_glyphs )
+      {
+        FT_Error  error = FT_Coverage_Add_Range( coverage, start, end );
+
+
+        if ( error )
+          return error;
+      }
+    }
+
+    return FT_Err_Ok;
+  }
+
+
   FT_CALLBACK_DEF( FT_Error )
   tt_cmap13_get_info( FT_CharMap    cmap,       /* TT_CMap */
                       TT_CMapInfo  *cmap_info )
@@ -2868,7 +3374,9 @@
 
     13,
     (TT_CMap_ValidateFunc)tt_cmap13_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap13_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap13_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)tt_cmap13_char_indices,  /* char_indices  */
+    (TT_CMap_Coverage_Func)tt_cmap13_get_coverage  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_13 */
@@ -3645,7 +4153,9 @@
 
     14,
     (TT_CMap_ValidateFunc)tt_cmap14_validate,  /* validate      */
-    (TT_CMap_Info_GetFunc)tt_cmap14_get_info   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)tt_cmap14_get_info,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)NULL,  /* char_indices  */
+    (TT_CMap_Coverage_Func)NULL  /* get_coverage  */
   )
 
 #endif /* TT_CONFIG_CMAP_FORMAT_14 */
@@ -3758,7 +4268,9 @@
 
     ~0U,
     (TT_CMap_ValidateFunc)NULL,  /* validate      */
-    (TT_CMap_Info_GetFunc)NULL   /* get_cmap_info */
+    (TT_CMap_Info_GetFunc)NULL,  /* get_cmap_info */
+    (TT_CMap_Char_Indices_Func)NULL,  /* char_indices  */
+    (TT_CMap_Coverage_Func)NULL  /* get_coverage  */
   )
 
 #endif /* FT_CONFIG_OPTION_POSTSCRIPT_NAMES */
@@ -3899,4 +4411,55 @@
   }
 
 
+  FT_LOCAL_DEF( FT_UInt )
+  tt_get_char_indices( FT_CharMap        charmap,
+                       const FT_UInt32*  char_codes,
+                       FT_UInt           count,
+                       FT_UInt*          gindices,
+                       FT_Bool           stop )
+  {
+    FT_CMap        cmap  = FT_CMAP( charmap );
+    TT_CMap_Class  clazz = (TT_CMap_Class)cmap->clazz;
+    FT_UInt        num_glyphs;
+    FT_UInt        n;
+
+
+    if ( clazz->char_indices )
+      return clazz->char_indices( charmap, char_codes, count, gindices, stop );
+
+    num_glyphs = (FT_UInt)charmap->face->num_glyphs;
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_UInt  gindex = cmap->clazz->char_index( cmap, char_codes[n] );
+
+
+      if ( gindex >= num_glyphs )
+        gindex = 0;
+
+      gindices[n] = gindex;
+
+      if ( stop && !gindex )
+        return n;
+    }
+
+    return count;
+  }
+
+
+  FT_LOCAL_DEF( FT_Error )
+  tt_get_coverage( FT_CharMap   charmap,
+                   FT_Coverage  coverage )
+  {
+    FT_CMap        cmap  = FT_CMAP( charmap );
+    TT_CMap_Class  clazz = (TT_CMap_Class)cmap->clazz;
+
+
+    if ( clazz->get_coverage )
+      return clazz->get_coverage( charmap, coverage );
+    else
+      return FT_THROW( Unimplemented_Feature );
+  }
+
+
 /* END */
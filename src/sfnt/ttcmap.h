@@ -47,10 +47,16 @@ FT_BEGIN_HEADER
 
   typedef struct  TT_CMap_ClassRec_
   {
-    FT_CMap_ClassRec      clazz;
-    FT_UInt               format;
-    TT_CMap_ValidateFunc  validate;
-    TT_CMap_Info_GetFunc  get_cmap_info;
+    FT_CMap_ClassRec           clazz;
+    FT_UInt                    format;
+    TT_CMap_ValidateFunc       validate;
+    TT_CMap_Info_GetFunc       get_cmap_info;
+
+    /* optional; specialized loop for `tt_get_char_indices` */
+    TT_CMap_Char_Indices_Func  char_indices;
+
+    /* optional; compute the coverage from the table structure */
+    TT_CMap_Coverage_Func      get_coverage;
 
   } TT_CMap_ClassRec;
 
@@ -68,7 +74,9 @@ FT_BEGIN_HEADER
                            variantchar_list_,  \
                            format_,            \
                            validate_,          \
-                           get_cmap_info_ )    \
+                           get_cmap_info_,     \
+                           char_indices_,      \
+                           get_coverage_ )     \
   FT_CALLBACK_TABLE_DEF                        \
   const TT_CMap_ClassRec  class_ =             \
   {                                            \
@@ -86,7 +94,9 @@ FT_BEGIN_HEADER
                                                \
     format_,                                   \
     validate_,                                 \
-    get_cmap_info_                             \
+    get_cmap_info_,                            \
+    char_indices_,                             \
+    get_coverage_                              \
   };
 
 
@@ -117,6 +127,19 @@ FT_BEGIN_HEADER
   tt_get_cmap_info( FT_CharMap    charmap,
                     TT_CMapInfo  *cmap_info );
 
+  /* used in tt-cmaps service */
+  FT_LOCAL( FT_UInt )
+  tt_get_char_indices( FT_CharMap        charmap,
+                       const FT_UInt32*  char_codes,
+                       FT_UInt           count,
+                       FT_UInt*          gindices,
+                       FT_Bool           stop );
+
+  /* used in tt-cmaps service */
+  FT_LOCAL( FT_Error )
+  tt_get_coverage( FT_CharMap   charmap,
+                   FT_Coverage  coverage );
+
 
 FT_END_HEADER
 
@@ -38,6 +38,37 @@
 #define TT_KERN_INDEX( g1, g2 )  ( ( (FT_ULong)(g1) << 16 ) | (g2) )
 
 
+  /* Check whether the pairs of a format 0 subtable are ordered. */
+  static FT_Bool
+  tt_kern_pairs_ordered( FT_Byte*  p,
+                         FT_UInt   num_pairs )
+  {
+    FT_ULong  old_pair;
+
+
+    if ( num_pairs == 0 )
+      return FALSE;
+
+    old_pair = FT_NEXT_ULONG( p );
+    p       += 2;
+
+    for ( ; num_pairs > 1; num_pairs-- )
+    {
+      FT_ULong  cur_pair;
+
+
+      cur_pair = FT_NEXT_ULONG( p );
+      if ( cur_pair < old_pair )
+        return FALSE;
+
+      p       += 2;
+      old_pair = cur_pair;
+    }
+
+    return TRUE;
+  }
+
+
   FT_LOCAL_DEF( FT_Error )
   tt_face_load_kern( TT_Face    face,
                      FT_Stream  stream )
@@ -47,7 +78,7 @@
     FT_Byte*   p;
     FT_Byte*   p_limit;
     FT_UInt    nn, num_tables;
-    FT_UInt32  avail = 0, ordered = 0;
+    FT_UInt32  avail = 0;
 
 
     /* the kern table is optional; exit silently if it is missing */
@@ -83,7 +114,7 @@
 
     for ( nn = 0; nn < num_tables; nn++ )
     {
-      FT_UInt    num_pairs, length, coverage, format;
+      FT_UInt    length, coverage, format;
       FT_Byte*   p_next;
       FT_UInt32  mask = (FT_UInt32)1UL << nn;
 
@@ -116,51 +147,19 @@
            p + 8 > p_next              )
         goto NextTable;
 
-      num_pairs = FT_NEXT_USHORT( p );
-      p        += 6;
-
-      if ( ( p_next - p ) < 6 * (int)num_pairs ) /* handle broken count */
-        num_pairs = (FT_UInt)( ( p_next - p ) / 6 );
-
+      /* Whether the pairs are ordered (so that we can use binary */
+      /* search) gets checked on first use; this avoids reading    */
+      /* the whole table while opening the face.                   */
       avail |= mask;
 
-      /*
-       * Now check whether the pairs in this table are ordered.
-       * We then can use binary search.
-       */
-      if ( num_pairs > 0 )
-      {
-        FT_ULong  count;
-        FT_ULong  old_pair;
-
-
-        old_pair = FT_NEXT_ULONG( p );
-        p       += 2;
-
-        for ( count = num_pairs - 1; count > 0; count-- )
-        {
-          FT_UInt32  cur_pair;
-
-
-          cur_pair = FT_NEXT_ULONG( p );
-          if ( cur_pair < old_pair )
-            break;
-
-          p += 2;
-          old_pair = cur_pair;
-        }
-
-        if ( count == 0 )
-          ordered |= mask;
-      }
-
     NextTable:
       p = p_next;
     }
 
-    face->num_kern_tables = nn;
-    face->kern_avail_bits = avail;
-    face->kern_order_bits = ordered;
+    face->num_kern_tables   = nn;
+    face->kern_avail_bits   = avail;
+    face->kern_order_bits   = 0;
+    face->kern_checked_bits = 0;
 
   Exit:
     return error;
@@ -174,10 +173,11 @@
 
 
     FT_FRAME_RELEASE( face->kern_table );
-    face->kern_table_size = 0;
-    face->num_kern_tables = 0;
-    face->kern_avail_bits = 0;
-    face->kern_order_bits = 0;
+    face->kern_table_size   = 0;
+    face->num_kern_tables   = 0;
+    face->kern_avail_bits   = 0;
+    face->kern_order_bits   = 0;
+    face->kern_checked_bits = 0;
   }
 
 
@@ -240,6 +240,13 @@
           FT_ULong  key0 = TT_KERN_INDEX( left_glyph, right_glyph );
 
 
+          if ( !( face->kern_checked_bits & mask ) )
+          {
+            if ( tt_kern_pairs_ordered( p, num_pairs ) )
+              face->kern_order_bits |= mask;
+            face->kern_checked_bits |= mask;
+          }
+
           if ( face->kern_order_bits & mask )   /* binary search */
           {
             FT_UInt   min = 0;
@@ -477,8 +477,10 @@ typedef ptrdiff_t  FT_PtrDist;
 #define FT_MAX_GRAY_POOL  ( 2048 / sizeof ( TCell ) )
 #endif
 
-  /* FT_Span buffer size for direct rendering only */
-#define FT_MAX_GRAY_SPANS  16
+  /* FT_Span buffer size for direct rendering only; it is large */
+  /* enough to pass most scanlines of complex glyphs (CJK, many  */
+  /* overlapping contours) with a single callback                */
+#define FT_MAX_GRAY_SPANS  64
 
 
 #if defined( _MSC_VER )      /* Visual C++ (and Intel C++) */
@@ -503,6 +505,9 @@ typedef ptrdiff_t  FT_PtrDist;
     PCell*      ycells;      /* array of cell linked-lists; one per      */
                              /* vertical coordinate in the current band  */
 
+    PCell       dense;       /* dense cell array of the current band     */
+    TCoord      dense_pitch; /* cells per row in dense mode, or zero     */
+
     TPos        x,  y;       /* last point position */
 
     FT_Outline  outline;     /* input outline */
@@ -595,6 +600,14 @@ typedef ptrdiff_t  FT_PtrDist;
 
       ex = FT_MAX( ex, ras.min_ex - 1 );
 
+      /* in dense mode, cells are addressed directly */
+      if ( ras.dense_pitch )
+      {
+        cell = ras.dense + ( ey - ras.min_ey ) * ras.dense_pitch +
+                           ( ex - ras.min_ex + 1 );
+        goto Found;
+      }
+
       while ( 1 )
       {
         cell = *pcell;
@@ -1859,11 +1872,104 @@ typedef ptrdiff_t  FT_PtrDist;
   }
 
 
+  /*
+   * Complex glyphs that overflow the cell pool are rendered in `dense
+   * mode': the pool is used as a two-dimensional array of cells, one
+   * per pixel of a band, which needs neither insertions into sorted
+   * lists nor band bisections.  Afterwards, the non-empty cells of each
+   * row are linked together so that the usual sweep functions can be
+   * used.
+   */
+  static TCoord
+  gray_dense_init( RAS_ARG )
+  {
+    TCoord  pitch = ras.max_ex - ras.min_ex + 1;
+    TCoord  rows, x;
+    PCell   cell;
+    size_t  n;
+
+
+    /* every row needs its cells and (less than) a cell for `ycells' */
+    rows = (TCoord)( ( ras.cell_null - ras.buffer ) / ( pitch + 1 ) );
+    if ( rows == 0 )
+      return 0;
+
+    n = ( (size_t)rows * sizeof ( PCell ) + sizeof ( TCell ) - 1 )
+          / sizeof ( TCell );
+
+    ras.dense       = ras.buffer + n;
+    ras.dense_pitch = pitch;
+
+    /* the cell values get reset after each band's sweep */
+    for ( cell = ras.dense; cell < ras.dense + rows * pitch; )
+    {
+      for ( x = ras.min_ex - 1; x < ras.max_ex; x++, cell++ )
+      {
+        cell->x     = x;
+        cell->cover = 0;
+        cell->area  = 0;
+      }
+    }
+
+    return rows;
+  }
+
+
+  static void
+  gray_dense_link( RAS_ARG )
+  {
+    TCoord  y;
+
+
+    for ( y = 0; y < ras.max_ey - ras.min_ey; y++ )
+    {
+      PCell  first = ras.dense + y * ras.dense_pitch;
+      PCell  cell  = first + ras.dense_pitch;
+      PCell  next  = ras.cell_null;
+
+
+      while ( cell > first )
+      {
+        cell--;
+
+        if ( cell->cover || cell->area )
+        {
+          cell->next = next;
+          next       = cell;
+        }
+      }
+
+      ras.ycells[y] = next;
+    }
+  }
+
+
+  static void
+  gray_dense_reset( RAS_ARG )
+  {
+    TCoord  y;
+
+
+    for ( y = 0; y < ras.max_ey - ras.min_ey; y++ )
+    {
+      PCell  cell = ras.ycells[y];
+
+
+      for ( ; cell != ras.cell_null; cell = cell->next )
+      {
+        cell->cover = 0;
+        cell->area  = 0;
+      }
+    }
+  }
+
+
   static int
   gray_convert_glyph( RAS_ARG )
   {
     TCoord   bands[32];  /* enough to accommodate bisections */
     TCoord*  band = bands;
+    TCoord   dense_rows = 0;
 
     int  continued = 0;
     int  error     = Smooth_Err_Ok;
@@ -1878,33 +1984,55 @@ typedef ptrdiff_t  FT_PtrDist;
     /* set up vertical bands */
     ras.ycells = (PCell*)ras.buffer;
 
+    ras.dense       = NULL;
+    ras.dense_pitch = 0;
+
     while ( 1 )
     {
       size_t  n;
       TCoord  i, count = ras.max_ey - ras.min_ey;
 
 
-      /* memory management: zero out and skip ycells */
-      for ( i = 0; i < count; ++i )
-        ras.ycells[i] = ras.cell_null;
+      if ( dense_rows )
+      {
+        /* bands are limited by the size of the dense cell array */
+        if ( count > dense_rows )
+        {
+          *band++    = ras.min_ey;
+          ras.min_ey = ras.max_ey - dense_rows;
+        }
+      }
+      else
+      {
+        /* memory management: zero out and skip ycells */
+        for ( i = 0; i < count; ++i )
+          ras.ycells[i] = ras.cell_null;
 
-      n = ( (size_t)count * sizeof ( PCell ) + sizeof ( TCell ) - 1 )
-            / sizeof ( TCell );
+        n = ( (size_t)count * sizeof ( PCell ) + sizeof ( TCell ) - 1 )
+              / sizeof ( TCell );
 
-      ras.cell_free = ras.buffer + n;
-      ras.cell      = ras.cell_null;
-      ras.error     = Smooth_Err_Ok;
+        ras.cell_free = ras.buffer + n;
+      }
+
+      ras.cell  = ras.cell_null;
+      ras.error = Smooth_Err_Ok;
 
       error     = gray_convert_glyph_inner( RAS_VAR_ continued );
       continued = 1;
 
       if ( !error )
       {
+        if ( dense_rows )
+          gray_dense_link( RAS_VAR );
+
         if ( ras.render_span )  /* for FT_RASTER_FLAG_DIRECT only */
           gray_sweep_direct( RAS_VAR );
         else
           gray_sweep( RAS_VAR );
 
+        if ( dense_rows )
+          gray_dense_reset( RAS_VAR );
+
         if ( band == bands )
           break;  /* done */
 
@@ -1915,7 +2043,19 @@ typedef ptrdiff_t  FT_PtrDist;
       else if ( error != Smooth_Err_Raster_Overflow )
         goto Exit;
 
-      /* render pool overflow, reduce the render band by half */
+      /* render pool overflow, switch to dense mode if possible */
+      if ( !dense_rows )
+      {
+        dense_rows = gray_dense_init( RAS_VAR );
+        if ( dense_rows )
+        {
+          FT_TRACE7(( "band [%d..%d]: switching to dense mode\n",
+                      ras.min_ey, ras.max_ey ));
+          continue;
+        }
+      }
+
+      /* otherwise reduce the render band by half */
       count >>= 1;
 
       /* this happens only if the rendering pool is too small */
@@ -112,6 +112,56 @@
 
       return error;
     }
+    else if ( !ft_strcmp( property_name, "outline-cache-size" ) )
+    {
+#ifdef FT_CONFIG_OPTION_ENVIRONMENT_PROPERTIES
+      if ( value_is_string )
+      {
+        const char*  s = (const char*)value;
+        long         n = ft_strtol( s, NULL, 10 );
+
+
+        if ( n < 0 )
+          return FT_THROW( Invalid_Argument );
+
+        driver->outline_cache_size = (FT_ULong)n;
+      }
+      else
+#endif
+      {
+        FT_ULong*  size = (FT_ULong*)value;
+
+
+        driver->outline_cache_size = *size;
+      }
+
+      return error;
+    }
+    else if ( !ft_strcmp( property_name, "gvar-cache-size" ) )
+    {
+#ifdef FT_CONFIG_OPTION_ENVIRONMENT_PROPERTIES
+      if ( value_is_string )
+      {
+        const char*  s = (const char*)value;
+        long         n = ft_strtol( s, NULL, 10 );
+
+
+        if ( n < 0 )
+          return FT_THROW( Invalid_Argument );
+
+        driver->gvar_cache_size = (FT_ULong)n;
+      }
+      else
+#endif
+      {
+        FT_ULong*  size = (FT_ULong*)value;
+
+
+        driver->gvar_cache_size = *size;
+      }
+
+      return error;
+    }
 
     FT_TRACE2(( "tt_property_set: missing property `%s'\n",
                 property_name ));
@@ -139,6 +189,51 @@
 
       return error;
     }
+    else if ( !ft_strcmp( property_name, "outline-cache-size" ) )
+    {
+      FT_ULong*  val = (FT_ULong*)value;
+
+
+      *val = driver->outline_cache_size;
+
+      return error;
+    }
+    else if ( !ft_strcmp( property_name, "gvar-cache-size" ) )
+    {
+      FT_ULong*  val = (FT_ULong*)value;
+
+
+      *val = driver->gvar_cache_size;
+
+      return error;
+    }
+    else if ( !ft_strcmp( property_name, "prep-cache-stats" ) )
+    {
+      FT_Prop_PrepCacheStats*  stats = (FT_Prop_PrepCacheStats*)value;
+      FT_Face                  face  = stats->face;
+
+
+      if ( !face || FT_FACE_DRIVER( face ) != (FT_Driver)module )
+        return FT_THROW( Invalid_Face_Handle );
+
+      stats->hits   = 0;
+      stats->misses = 0;
+
+#ifdef TT_USE_BYTECODE_INTERPRETER
+      {
+        TT_PrepCache  cache = (TT_PrepCache)( (TT_Face)face )->prep_cache;
+
+
+        if ( cache )
+        {
+          stats->hits   = cache->hits;
+          stats->misses = cache->misses;
+        }
+      }
+#endif
+
+      return error;
+    }
 
     FT_TRACE2(( "tt_property_get: missing property `%s'\n",
                 property_name ));
@@ -271,19 +366,32 @@
     }
     else
     {
-#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
-      /* no fast retrieval for blended MM fonts without HVAR table */
-      if ( ( FT_IS_NAMED_INSTANCE( face ) || FT_IS_VARIATION( face ) ) &&
-           !( ttface->variation_support & TT_FACE_FLAG_VAR_HADVANCE )  )
-        return FT_THROW( Unimplemented_Feature );
-#endif
-
       for ( nn = 0; nn < count; nn++ )
       {
         FT_Short   lsb;
         FT_UShort  aw;
 
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+        /* For blended MM fonts without HVAR table, apply the `gvar'  */
+        /* deltas of the phantom points.  Note that the flag gets set */
+        /* only after the HVAR table has been loaded on first access. */
+        if ( ( FT_IS_NAMED_INSTANCE( face ) || FT_IS_VARIATION( face ) ) &&
+             !( ttface->variation_support & TT_FACE_FLAG_VAR_HADVANCE )  )
+        {
+          FT_Error  error;
+          FT_Int    linear;
+
+
+          error = TT_Get_Varied_HAdvance( ttface, start + nn, &linear );
+          if ( error )
+            return error;
+
+          advances[nn] = linear;
+          continue;
+        }
+#endif
+
         TT_Get_HMetrics( ttface, start + nn, &lsb, &aw );
         advances[nn] = aw;
       }
@@ -146,6 +146,206 @@
   }
 
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+
+  /* Compute the linear advance width of a glyph in a font without an */
+  /* `HVAR' table the same way as `load_truetype_glyph' does, but     */
+  /* without loading the outline.  From the `glyf' table we only need */
+  /* the number of points (or components) to locate the phantom       */
+  /* points in the `gvar' data, together with the component whose     */
+  /* metrics are used by a composite glyph.                           */
+  static FT_Error
+  tt_get_varied_hadvance( TT_Face  face,
+                          FT_UInt  glyph_index,
+                          FT_UInt  recurse_count,
+                          FT_Int*  alinear )
+  {
+    FT_Error   error  = FT_Err_Ok;
+    FT_Stream  stream = face->root.stream;
+    FT_ULong   offset;
+    FT_ULong   byte_len;
+    FT_Short   lsb;
+    FT_UShort  aw;
+
+    FT_UInt  n_points           = 0;
+    FT_UInt  metrics_glyph      = 0;
+    FT_UInt  num_metrics_glyphs = 0;
+
+
+    /* see `load_truetype_glyph' */
+    if ( recurse_count > 100 )
+      return FT_THROW( Invalid_Composite );
+
+    if ( glyph_index >= (FT_UInt)face->root.num_glyphs )
+      return FT_THROW( Invalid_Glyph_Index );
+
+    offset = tt_face_get_location( FT_FACE( face ), glyph_index, &byte_len );
+
+    if ( byte_len > 0 )
+    {
+      FT_Byte*  p;
+      FT_Byte*  limit;
+      FT_Int    n_contours;
+
+
+      if ( !face->glyf_offset )
+        return FT_THROW( Invalid_Table );
+
+      if ( FT_STREAM_SEEK( face->glyf_offset + offset ) ||
+           FT_FRAME_ENTER( byte_len )                   )
+        return error;
+
+      p     = stream->cursor;
+      limit = stream->limit;
+
+      if ( p + 10 > limit )
+      {
+        error = FT_THROW( Invalid_Outline );
+        goto Exit;
+      }
+
+      n_contours = FT_NEXT_SHORT( p );
+      p         += 8;                 /* skip bounding box */
+
+      if ( n_contours > 0 )
+      {
+        FT_Int  n;
+
+
+        if ( n_contours >= 0xFFF || p + 2 * n_contours + 2 > limit )
+        {
+          error = FT_THROW( Invalid_Outline );
+          goto Exit;
+        }
+
+        for ( n = 0; n < n_contours; n++ )
+        {
+          FT_UInt  last = FT_NEXT_USHORT( p );
+
+
+          if ( last < n_points )
+          {
+            error = FT_THROW( Invalid_Outline );
+            goto Exit;
+          }
+
+          n_points = last + 1;
+        }
+      }
+      else if ( n_contours < 0 )
+      {
+        FT_UInt  flags;
+
+
+        /* one point per component, cf. `load_truetype_glyph' */
+        do
+        {
+          FT_UInt  index;
+          FT_UInt  count;
+
+
+          if ( p + 4 > limit )
+          {
+            error = FT_THROW( Invalid_Composite );
+            goto Exit;
+          }
+
+          flags = FT_NEXT_USHORT( p );
+          index = FT_NEXT_USHORT( p );
+
+          if ( index >= (FT_UInt)face->root.num_glyphs )
+          {
+            error = FT_THROW( Invalid_Composite );
+            goto Exit;
+          }
+
+          /* repeating the same component doesn't change the result */
+          if ( flags & USE_MY_METRICS                           &&
+               ( !num_metrics_glyphs || index != metrics_glyph ) )
+          {
+            metrics_glyph = index;
+            num_metrics_glyphs++;
+          }
+
+          count = 2;
+          if ( flags & ARGS_ARE_WORDS )
+            count += 2;
+          if ( flags & WE_HAVE_A_SCALE )
+            count += 2;
+          else if ( flags & WE_HAVE_AN_XY_SCALE )
+            count += 4;
+          else if ( flags & WE_HAVE_A_2X2 )
+            count += 8;
+
+          if ( p + count > limit )
+          {
+            error = FT_THROW( Invalid_Composite );
+            goto Exit;
+          }
+
+          p += count;
+          n_points++;
+
+        } while ( flags & MORE_COMPONENTS );
+      }
+
+    Exit:
+      FT_FRAME_EXIT();
+
+      if ( error )
+        return error;
+    }
+
+    TT_Get_HMetrics( face, glyph_index, &lsb, &aw );
+
+    if ( !recurse_count )
+      *alinear = aw;
+
+    error = TT_Vary_Get_HAdvance( face, glyph_index, n_points, aw, alinear );
+    if ( error )
+      return error;
+
+    /* The advance width of the last component with `USE_MY_METRICS' */
+    /* wins.  Since that component might have no variation data, its */
+    /* predecessors would have to be handled, too, if they refer to   */
+    /* other glyphs; this is rare enough to simply let the caller     */
+    /* load the glyph instead.                                        */
+    if ( num_metrics_glyphs > 1 )
+      return FT_THROW( Unimplemented_Feature );
+
+    if ( num_metrics_glyphs )
+      error = tt_get_varied_hadvance( face,
+                                      metrics_glyph,
+                                      recurse_count + 1,
+                                      alinear );
+
+    return error;
+  }
+
+
+  /**************************************************************************
+   *
+   * Return the horizontal advance width in font units for a given glyph of
+   * a varied font without an `HVAR' table.  The result equals the linear
+   * advance width returned by `TT_Load_Glyph'.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Get_Varied_HAdvance( TT_Face  face,
+                          FT_UInt  idx,
+                          FT_Int*  aw )
+  {
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+    /* the glyph data might not be available */
+    if ( face->root.internal->incremental_interface )
+      return FT_THROW( Unimplemented_Feature );
+#endif
+
+    return tt_get_varied_hadvance( face, idx, 0, aw );
+  }
+
+#endif /* TT_CONFIG_OPTION_GX_VAR_SUPPORT */
+
+
   static FT_Error
   tt_get_metrics( TT_Loader  loader,
                   FT_UInt    glyph_index )
@@ -1385,6 +1585,178 @@
   }
 
 
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_face_done_outline_cache
+   *
+   * @Description:
+   *   Free the outline cache of a face.
+   *
+   * @Input:
+   *   face ::
+   *     A handle to the target face object.
+   */
+  FT_LOCAL_DEF( void )
+  tt_face_done_outline_cache( TT_Face  face )
+  {
+    FT_Memory        memory = face->root.memory;
+    TT_OutlineCache  cache  = (TT_OutlineCache)face->outline_cache;
+    FT_Long          i;
+
+
+    if ( !cache )
+      return;
+
+    for ( i = 0; i < face->root.num_glyphs; i++ )
+      FT_FREE( cache->outlines[i] );
+
+    FT_FREE( cache->outlines );
+    FT_FREE( face->outline_cache );
+  }
+
+
+  /* check whether the outline cache can be used for the current glyph */
+  static FT_Bool
+  tt_loader_use_outline_cache( TT_Loader  loader )
+  {
+    TT_Face    face   = loader->face;
+    TT_Driver  driver = (TT_Driver)FT_FACE_DRIVER( face );
+
+
+    /* we don't cache glyph instructions */
+    if ( IS_HINTED( loader->load_flags ) )
+      return FALSE;
+
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+    /* glyph data might change */
+    if ( face->root.internal->incremental_interface )
+      return FALSE;
+#endif
+
+    return FT_BOOL( face->outline_cache || driver->outline_cache_size );
+  }
+
+
+  /* get a cached outline; this only succeeds for simple glyphs */
+  static TT_CachedOutline
+  tt_loader_get_cached_outline( TT_Loader  loader,
+                                FT_UInt    glyph_index )
+  {
+    TT_OutlineCache  cache = (TT_OutlineCache)loader->face->outline_cache;
+
+
+    if ( !cache                                               ||
+         glyph_index >= (FT_UInt)loader->face->root.num_glyphs ||
+         !tt_loader_use_outline_cache( loader )                )
+      return NULL;
+
+    return cache->outlines[glyph_index];
+  }
+
+
+  /* copy a cached outline to the glyph loader, */
+  /* replacing `TT_Load_Simple_Glyph'           */
+  static FT_Error
+  tt_loader_load_cached_outline( TT_Loader         loader,
+                                 TT_CachedOutline  cached )
+  {
+    FT_Error        error;
+    FT_GlyphLoader  gloader = loader->gloader;
+    FT_Outline*     outline = &gloader->current.outline;
+
+
+    /* note that we will add four phantom points later */
+    error = FT_GLYPHLOADER_CHECK_POINTS( gloader,
+                                         cached->n_points + 4,
+                                         cached->n_contours );
+    if ( error )
+      return error;
+
+    FT_ARRAY_COPY( outline->points, cached->points, cached->n_points );
+    FT_ARRAY_COPY( outline->tags, cached->tags, cached->n_points );
+    FT_ARRAY_COPY( outline->contours, cached->contours, cached->n_contours );
+
+    outline->n_points   = (FT_UShort)cached->n_points;
+    outline->n_contours = (FT_UShort)cached->n_contours;
+
+    if ( cached->overlap )
+      gloader->base.outline.flags |= FT_OUTLINE_OVERLAP;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* store the simple glyph just loaded by `TT_Load_Simple_Glyph' */
+  /* if the memory limit allows; errors are ignored               */
+  static void
+  tt_loader_add_cached_outline( TT_Loader  loader,
+                                FT_UInt    glyph_index,
+                                FT_Bool    overlap )
+  {
+    TT_Face      face    = loader->face;
+    FT_Memory    memory  = face->root.memory;
+    TT_Driver    driver  = (TT_Driver)FT_FACE_DRIVER( face );
+    FT_Outline*  outline = &loader->gloader->current.outline;
+    FT_Error     error;
+
+    TT_OutlineCache   cache = (TT_OutlineCache)face->outline_cache;
+    TT_CachedOutline  cached;
+    FT_ULong          size;
+
+
+    if ( glyph_index >= (FT_UInt)face->root.num_glyphs )
+      return;
+
+    if ( !cache )
+    {
+      size = (FT_ULong)face->root.num_glyphs * sizeof ( TT_CachedOutline );
+      if ( size + sizeof ( TT_OutlineCacheRec ) >
+             driver->outline_cache_size )
+        return;
+
+      if ( FT_NEW( cache ) )
+        return;
+
+      if ( FT_NEW_ARRAY( cache->outlines, face->root.num_glyphs ) )
+      {
+        FT_FREE( cache );
+        return;
+      }
+
+      cache->num_bytes    = size + sizeof ( TT_OutlineCacheRec );
+      face->outline_cache = cache;
+    }
+
+    size = sizeof ( TT_CachedOutlineRec )                          +
+           (FT_ULong)outline->n_points * ( sizeof ( FT_Vector ) + 1 ) +
+           (FT_ULong)outline->n_contours * sizeof ( FT_UShort );
+
+    if ( cache->num_bytes + size > driver->outline_cache_size ||
+         cache->outlines[glyph_index]                         )
+      return;
+
+    if ( FT_QALLOC( cached, size ) )
+      return;
+
+    cached->bbox       = loader->bbox;
+    cached->n_contours = outline->n_contours;
+    cached->n_points   = (FT_UShort)outline->n_points;
+    cached->overlap    = overlap;
+
+    cached->points   = (FT_Vector*)( cached + 1 );
+    cached->contours = (FT_UShort*)( cached->points + outline->n_points );
+    cached->tags     = (FT_Byte*)( cached->contours + outline->n_contours );
+
+    FT_ARRAY_COPY( cached->points, outline->points, outline->n_points );
+    FT_ARRAY_COPY( cached->contours, outline->contours, outline->n_contours );
+    FT_ARRAY_COPY( cached->tags, outline->tags, outline->n_points );
+
+    cache->outlines[glyph_index] = cached;
+    cache->num_bytes            += size;
+  }
+
+
   /**************************************************************************
    *
    * @Function:
@@ -1408,6 +1780,8 @@
 
     FT_Bool  opened_frame = 0;
 
+    TT_CachedOutline  cached = NULL;
+
 #ifdef FT_CONFIG_OPTION_INCREMENTAL
     FT_StreamRec    inc_stream;
     FT_Data         glyph_data;
@@ -1513,19 +1887,29 @@
         goto Exit;
       }
 
-      error = face->access_glyph_frame( loader, glyph_index,
-                                        face->glyf_offset + offset,
-                                        loader->byte_len );
-      if ( error )
-        goto Exit;
+      /* a simple glyph might be in the outline cache */
+      cached = tt_loader_get_cached_outline( loader, glyph_index );
+      if ( cached )
+      {
+        loader->n_contours = cached->n_contours;
+        loader->bbox       = cached->bbox;
+      }
+      else
+      {
+        error = face->access_glyph_frame( loader, glyph_index,
+                                          face->glyf_offset + offset,
+                                          loader->byte_len );
+        if ( error )
+          goto Exit;
 
-      /* read glyph header first */
-      error = face->read_glyph_header( loader );
+        /* read glyph header first */
+        error = face->read_glyph_header( loader );
 
-      face->forget_glyph_frame( loader );
+        face->forget_glyph_frame( loader );
 
-      if ( error )
-        goto Exit;
+        if ( error )
+          goto Exit;
+      }
     }
 
     /* a space glyph */
@@ -1613,6 +1997,20 @@
     /***********************************************************************/
     /***********************************************************************/
 
+    if ( cached )
+    {
+      error = tt_loader_load_cached_outline( loader, cached );
+      if ( error )
+        goto Exit;
+
+      error = TT_Process_Simple_Glyph( loader );
+      if ( error )
+        goto Exit;
+
+      FT_GlyphLoader_Add( gloader );
+      goto Exit;
+    }
+
     /* we now open a frame again, right after the glyph header */
     /* (which consists of 10 bytes)                            */
     error = face->access_glyph_frame( loader, glyph_index,
@@ -1627,7 +2025,27 @@
 
     if ( loader->n_contours > 0 )
     {
+      FT_Bool  use_cache = tt_loader_use_outline_cache( loader );
+      FT_Int   flags     = gloader->base.outline.flags;
+
+
+      /* isolate the overlap flag of this glyph */
+      if ( use_cache )
+        gloader->base.outline.flags &= ~FT_OUTLINE_OVERLAP;
+
       error = face->read_simple_glyph( loader );
+
+      if ( use_cache )
+      {
+        if ( !error )
+          tt_loader_add_cached_outline(
+            loader,
+            glyph_index,
+            FT_BOOL( gloader->base.outline.flags & FT_OUTLINE_OVERLAP ) );
+
+        gloader->base.outline.flags |= flags & FT_OUTLINE_OVERLAP;
+      }
+
       if ( error )
         goto Exit;
 
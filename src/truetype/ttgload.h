@@ -30,6 +30,51 @@
 FT_BEGIN_HEADER
 
 
+  /**************************************************************************
+   *
+   * @Struct:
+   *   TT_CachedOutlineRec
+   *
+   * @Description:
+   *   A decoded simple glyph from the 'glyf' table in font units, before
+   *   applying variation deltas.  The arrays directly follow the
+   *   structure in memory.
+   */
+  typedef struct  TT_CachedOutlineRec_
+  {
+    FT_BBox     bbox;
+    FT_Short    n_contours;
+    FT_UShort   n_points;
+    FT_Bool     overlap;
+
+    FT_Vector*  points;
+    FT_UShort*  contours;
+    FT_Byte*    tags;
+
+  } TT_CachedOutlineRec, *TT_CachedOutline;
+
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   TT_OutlineCacheRec
+   *
+   * @Description:
+   *   A per-face cache of decoded simple glyphs, used for unhinted
+   *   loading.  Its size is limited by the driver's `outline-cache-size`
+   *   property; no entries are added once the limit is reached.
+   */
+  typedef struct  TT_OutlineCacheRec_
+  {
+    FT_ULong           num_bytes;  /* including the `outlines' array */
+    TT_CachedOutline*  outlines;   /* indexed by glyph index          */
+
+  } TT_OutlineCacheRec, *TT_OutlineCache;
+
+
+  FT_LOCAL( void )
+  tt_face_done_outline_cache( TT_Face  face );
+
   FT_LOCAL( void )
   TT_Init_Glyph_Loading( TT_Face  face );
 
@@ -46,6 +91,13 @@ FT_BEGIN_HEADER
                    FT_Short*   tsb,
                    FT_UShort*  ah );
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+  FT_LOCAL( FT_Error )
+  TT_Get_Varied_HAdvance( TT_Face  face,
+                          FT_UInt  idx,
+                          FT_Int*  aw );
+#endif
+
   FT_LOCAL( FT_Error )
   TT_Load_Glyph( TT_Size       size,
                  TT_GlyphSlot  glyph,
@@ -264,22 +264,21 @@
    *     The size of `scratch`.
    *
    * @Return:
-   *   An array of FT_Fixed containing the deltas for the affected
+   *   An array of FT_Short containing the deltas for the affected
    *   points.  (This only gets the deltas for one dimension.  It will
    *   generally be called twice, once for x, once for y.  When used in
    *   cvt table, it will only be called once.)
    *
-   *   We use FT_Fixed to avoid accumulation errors while summing up all
-   *   deltas (the rounding to integer values happens as the very last
-   *   step).
+   *   The deltas are summed up in FT_Fixed to avoid accumulation errors
+   *   (the rounding to integer values happens as the very last step).
    */
-  static FT_Fixed*
+  static FT_Short*
   ft_var_readpackeddeltas( FT_Stream  stream,
                            FT_UInt    delta_cnt,
-                           FT_Fixed*  scratch,
+                           FT_Short*  scratch,
                            FT_UInt    scratch_cap )
   {
-    FT_Fixed  *deltas = NULL;
+    FT_Short  *deltas = NULL;
     FT_UInt    runcnt, cnt;
     FT_UInt    i, j;
     FT_Byte*   p;
@@ -320,7 +319,7 @@
           goto Fail;
 
         for ( j = 0; j < cnt; j++ )
-          deltas[i++] = FT_intToFixed( FT_NEXT_SHORT( p ) );
+          deltas[i++] = FT_NEXT_SHORT( p );
       }
       else
       {
@@ -328,7 +327,7 @@
           goto Fail;
 
         for ( j = 0; j < cnt; j++ )
-          deltas[i++] = FT_intToFixed( FT_NEXT_CHAR( p ) );
+          deltas[i++] = FT_NEXT_CHAR( p );
       }
     }
 
@@ -1201,9 +1200,8 @@
 
     GX_ItemVarData  varData;
 
-    FT_UInt    master;
+    FT_UInt    master, word_count;
     FT_Int64   returnValue = FT_INT64_ZERO;
-    FT_UInt    shift_base  = 1;
     FT_UInt    per_region_size;
     FT_Byte*   bytes;
     FT_Fixed*  regionScalars;
@@ -1237,118 +1235,92 @@
     /* if `longWords` isn't set, and twice as much otherwise.      */
     per_region_size = varData->wordDeltaCount + varData->regionIdxCount;
     if ( varData->longWords )
-    {
-      shift_base       = 2;
       per_region_size *= 2;
-    }
 
     bytes = varData->deltaSet + per_region_size * innerIndex;
 
     /* The region scalars depend only on the normalized coordinates, which */
     /* are constant while glyphs are loaded; yet this function is called   */
     /* once per item (e.g., per glyph for 'HVAR' advances).  Cache the     */
-    /* scalars per store and recompute only when the coordinates change.   */
+    /* scalars per store and recompute them only if `coords_serial` of the */
+    /* blend has changed since, i.e., if new coordinates have been set.    */
     /* `regionScalars` stays NULL (falling back to recomputation) if the   */
     /* cache cannot be allocated.                                          */
     regionScalars = itemStore->regionScalars;
-    {
-      FT_Fixed*  ncoords = ttface->blend->normalizedcoords;
-      FT_Bool    fresh   = FT_BOOL( regionScalars != NULL );
-      FT_UInt    a;
-
-
-      if ( fresh )
-      {
-        for ( a = 0; a < itemStore->axisCount; a++ )
-          if ( itemStore->cachedCoords[a] != ncoords[a] )
-          {
-            fresh = FALSE;
-            break;
-          }
-      }
-
-      if ( !fresh )
-      {
-        FT_Memory  memory = FT_FACE_MEMORY( face );
-        FT_Error   error  = FT_Err_Ok;
-
-        FT_UNUSED( error );
 
+    if ( !regionScalars                                           ||
+         itemStore->cachedSerial != ttface->blend->coords_serial )
+    {
+      FT_Memory  memory = FT_FACE_MEMORY( face );
+      FT_Error   error  = FT_Err_Ok;
 
-        if ( !regionScalars )
-        {
-          if ( !FT_QNEW_ARRAY( itemStore->regionScalars,
-                               itemStore->regionCount ) &&
-               !FT_QNEW_ARRAY( itemStore->cachedCoords,
-                               itemStore->axisCount )   )
-            regionScalars = itemStore->regionScalars;
-          else
-          {
-            FT_FREE( itemStore->regionScalars );
-            FT_FREE( itemStore->cachedCoords );
-          }
-        }
-
-        if ( regionScalars )
-        {
-          FT_UInt  r;
+      FT_UNUSED( error );
 
 
-          for ( r = 0; r < itemStore->regionCount; r++ )
-            regionScalars[r] = tt_calculate_scalar(
-                                 itemStore->varRegionList[r].axisList,
-                                 itemStore->axisCount,
-                                 ncoords );
-          for ( a = 0; a < itemStore->axisCount; a++ )
-            itemStore->cachedCoords[a] = ncoords[a];
-        }
-      }
-    }
+      if ( !regionScalars                                  &&
+           !FT_QNEW_ARRAY( itemStore->regionScalars,
+                           itemStore->regionCount )        )
+        regionScalars = itemStore->regionScalars;
 
-    /* outer loop steps through master designs to be blended */
-    for ( master = 0; master < varData->regionIdxCount; master++ )
-    {
-      FT_UInt  regionIndex = varData->regionIndices[master];
+      if ( regionScalars )
+      {
+        FT_UInt  r;
 
-      GX_AxisCoords  axis = itemStore->varRegionList[regionIndex].axisList;
 
-      FT_Fixed  scalar = regionScalars
-                           ? regionScalars[regionIndex]
-                           : tt_calculate_scalar(
-                               axis,
+        for ( r = 0; r < itemStore->regionCount; r++ )
+          regionScalars[r] = tt_calculate_scalar(
+                               itemStore->varRegionList[r].axisList,
                                itemStore->axisCount,
                                ttface->blend->normalizedcoords );
 
+        itemStore->cachedSerial = ttface->blend->coords_serial;
+      }
+    }
 
-      if ( scalar )
-      {
-        FT_Int  delta;
-
+#define GX_REGION_SCALAR( master )                                        \
+          ( regionScalars                                                 \
+              ? regionScalars[varData->regionIndices[master]]             \
+              : tt_calculate_scalar(                                      \
+                  itemStore->varRegionList[varData->regionIndices[master]] \
+                    .axisList,                                            \
+                  itemStore->axisCount,                                   \
+                  ttface->blend->normalizedcoords ) )
 
-        if ( varData->longWords )
-        {
-          if ( master < varData->wordDeltaCount )
-            delta = FT_NEXT_LONG( bytes );
-          else
-            delta = FT_NEXT_SHORT( bytes );
-        }
-        else
-        {
-          if ( master < varData->wordDeltaCount )
-            delta = FT_NEXT_SHORT( bytes );
-          else
-            delta = FT_NEXT_CHAR( bytes );
-        }
+    /* The first `wordDeltaCount` deltas use the larger format.  Handling */
+    /* both parts in separate loops without tests of the scalar (adding   */
+    /* zero is harmless) makes the loops tight; the result is identical.  */
+    word_count = FT_MIN( varData->wordDeltaCount, varData->regionIdxCount );
 
-        returnValue = ft_mul_add_delta_scalar( returnValue, delta, scalar );
-      }
-      else
-      {
-        /* Branch-free, yay. */
-        bytes += shift_base << ( master < varData->wordDeltaCount );
-      }
+    if ( varData->longWords )
+    {
+      for ( master = 0; master < word_count; master++ )
+        returnValue = ft_mul_add_delta_scalar(
+                        returnValue,
+                        (FT_Int32)FT_NEXT_LONG( bytes ),
+                        (FT_Int32)GX_REGION_SCALAR( master ) );
+
+      for ( ; master < varData->regionIdxCount; master++ )
+        returnValue = ft_mul_add_delta_scalar(
+                        returnValue,
+                        FT_NEXT_SHORT( bytes ),
+                        (FT_Int32)GX_REGION_SCALAR( master ) );
+    }
+    else
+    {
+      for ( master = 0; master < word_count; master++ )
+        returnValue = ft_mul_add_delta_scalar(
+                        returnValue,
+                        FT_NEXT_SHORT( bytes ),
+                        (FT_Int32)GX_REGION_SCALAR( master ) );
+
+      for ( ; master < varData->regionIdxCount; master++ )
+        returnValue = ft_mul_add_delta_scalar(
+                        returnValue,
+                        FT_NEXT_CHAR( bytes ),
+                        (FT_Int32)GX_REGION_SCALAR( master ) );
+    }
 
-    } /* per-region loop */
+#undef GX_REGION_SCALAR
 
     return ft_round_and_shift16( returnValue );
   }
@@ -2357,6 +2329,7 @@
         /* Item Variation Store to work with.                   */
         old_normalized                = face->blend->normalizedcoords;
         face->blend->normalizedcoords = normalized;
+        face->blend->coords_serial++;
 
         for ( i = 0; i < mmvar->num_axis; i++ )
         {
@@ -2399,6 +2372,7 @@
         }
 
         face->blend->normalizedcoords = old_normalized;
+        face->blend->coords_serial++;
 
         FT_FREE( new_normalized );
       }
@@ -3184,6 +3158,9 @@
                    coords,
                    num_coords * sizeof ( FT_Fixed ) );
 
+    /* invalidate cached region scalars of item variation stores */
+    blend->coords_serial++;
+
     if ( set_design_coords )
       ft_var_to_design( face,
                         all_design_coords ? blend->num_axis : num_coords,
@@ -3834,7 +3811,7 @@
     FT_UShort*  localpoints  = NULL;
     FT_UShort*  points;
 
-    FT_Fixed*  deltas     = NULL;
+    FT_Short*  deltas     = NULL;
     FT_Fixed*  cvt_deltas = NULL;
 
 
@@ -4011,7 +3988,8 @@
 
 
           old_cvt_delta = cvt_deltas[j];
-          cvt_deltas[j] = old_cvt_delta + FT_MulFix( deltas[j], apply );
+          cvt_deltas[j] = old_cvt_delta +
+                            FT_MulFix( FT_intToFixed( deltas[j] ), apply );
 
 #ifdef FT_DEBUG_LEVEL_TRACE
           if ( old_cvt_delta != cvt_deltas[j] )
@@ -4053,7 +4031,9 @@
             continue;
 
           old_cvt_delta      = cvt_deltas[pindex];
-          cvt_deltas[pindex] = old_cvt_delta + FT_MulFix( deltas[j], apply );
+          cvt_deltas[pindex] = old_cvt_delta +
+                                 FT_MulFix( FT_intToFixed( deltas[j] ),
+                                            apply );
 
 #ifdef FT_DEBUG_LEVEL_TRACE
           if ( old_cvt_delta != cvt_deltas[pindex] )
@@ -4197,9 +4177,19 @@
       d1   = out1 - in1;
       d2   = out2 - in2;
 
+      /* If both reference points move by the same amount, every point  */
+      /* in the range gets that delta: the interpolation scale is then  */
+      /* exactly 1.0, and `FT_MulFix' by 1.0 is exact.  This is by far  */
+      /* the most frequent case and reduces to a plain, branchless add. */
+      if ( d1 == d2 )
+      {
+        for ( p = p1; p <= p2; p++ )
+          out_points[p].x = in_points[p].x + d1;
+      }
+
       /* If the reference points have the same coordinate but different */
       /* delta, inferred delta is zero.  Otherwise interpolate.         */
-      if ( in1 != in2 || out1 == out2 )
+      else if ( in1 != in2 || out1 == out2 )
       {
         FT_Fixed  scale = in1 != in2 ? FT_DivFix( out2 - out1, in2 - in1 )
                                      : 0;
@@ -4310,216 +4300,949 @@
   }
 
 
-  /**************************************************************************
-   *
-   * @Function:
-   *   TT_Vary_Apply_Glyph_Deltas
-   *
-   * @Description:
-   *   Apply the appropriate deltas to the current glyph.
-   *
-   * @InOut:
-   *   loader ::
-   *     A handle to the loader object.
-   *
-   *   outline ::
-   *     The outline to change, with appended phantom points.
-   *
-   * @Output:
-   *   unrounded ::
-   *     An array with `n_points' elements that is filled with unrounded
-   *     point coordinates (in 26.6 format).
-   *
-   * @Return:
-   *   FreeType error code.  0 means success.
-   */
-  FT_LOCAL_DEF( FT_Error )
-  TT_Vary_Apply_Glyph_Deltas( TT_Loader    loader,
-                              FT_Outline*  outline,
-                              FT_Vector*   unrounded )
-  {
-    FT_Error   error       = FT_Err_Ok;
-    TT_Face    face        = loader->face;
-    FT_Stream  stream      = face->root.stream;
-    FT_Memory  memory      = stream->memory;
-    FT_UInt    glyph_index = loader->glyph_index;
-    FT_UInt    n_points    = (FT_UInt)outline->n_points + 4;
+  /* Scale an integer delta by a tuple scalar, giving a 16.16 value.  */
+  /* Scalars computed by `ft_var_apply_tuple' are always in the range  */
+  /* [0;1], so the product always fits into 32 bits; it is identical   */
+  /* to `FT_MulFix( FT_intToFixed( delta ), scalar )' since the latter */
+  /* has nothing to round.                                             */
+#define GX_SCALE_DELTA( delta, scalar )  ( (FT_Fixed)(delta) * (scalar) )
 
-    FT_Vector*  points_org = NULL;  /* coordinates in 16.16 format */
-    FT_Vector*  points_out = NULL;  /* coordinates in 16.16 format */
-    FT_Bool*    has_delta  = NULL;
 
-    FT_ULong  glyph_start;
+  /* Add `count' deltas, scaled by `scalar', to the accumulator array */
+  /* `sums'.  The loop is kept free of any other work so that the     */
+  /* compiler can unroll or vectorize it.                             */
+  static void
+  ft_var_accumulate_deltas( FT_Fixed*        sums,
+                            const FT_Short*  deltas,
+                            FT_UInt          count,
+                            FT_Fixed         scalar )
+  {
+    FT_UInt  j;
 
-    FT_UInt   tupleCount;
-    FT_ULong  offsetToData;
-    FT_ULong  dataSize;
 
-    FT_ULong  here;
-    FT_UInt   i, j;
+    for ( j = 0; j < count; j++ )
+      sums[j] += GX_SCALE_DELTA( deltas[j], scalar );
+  }
 
-    FT_UInt   peak_coords_size;
-    FT_UInt   point_deltas_x_size;
-    FT_UInt   deltas_buf_size;
-    FT_UInt   points_buf_size;
-    FT_UInt   points_org_size;
-    FT_UInt   points_out_size;
-    FT_UInt   has_delta_size;
-    FT_UInt   pool_size;
-    FT_Byte*  pool = NULL;
-    FT_Byte*  p;
 
-    FT_Fixed*  peak_coords = NULL;
-    FT_Fixed*  tuple_coords;
-    FT_Fixed*  im_start_coords;
-    FT_Fixed*  im_end_coords;
+  /* Add the deltas of a single tuple variation, scaled by `apply', to */
+  /* `point_deltas_x' and `point_deltas_y'.  If the tuple doesn't cover */
+  /* all points (i.e., `points' isn't `ALL_POINTS'), infer the missing  */
+  /* deltas similar to the IUP bytecode instruction, using `points_org' */
+  /* and the scratch arrays `points_out' and `has_delta'.               */
+  static void
+  ft_var_apply_glyph_tuple( FT_Outline*  outline,
+                            FT_UInt      n_points,
+                            FT_Fixed     apply,
+                            FT_UShort*   points,
+                            FT_UInt      point_count,
+                            FT_Short*    deltas_x,
+                            FT_Short*    deltas_y,
+                            FT_Vector*   points_org,
+                            FT_Vector*   points_out,
+                            FT_Bool*     has_delta,
+                            FT_Fixed*    point_deltas_x,
+                            FT_Fixed*    point_deltas_y )
+  {
+    FT_UInt  j;
 
-    GX_Blend  blend = face->blend;
 
-    FT_UInt  point_count;
-    FT_UInt  spoint_count = 0;
+    if ( points == ALL_POINTS )
+    {
+#ifdef FT_DEBUG_LEVEL_TRACE
+      int  count = 0;
+#endif
 
-    FT_UShort*  sharedpoints      = NULL;
-    FT_UShort*  localpoints       = NULL;
-    FT_UShort*  points;
-    /* scratch buffer pool for `sharedpoints` */
-    FT_UShort*  shared_points_buf = NULL;
-    /* scratch buffer pool for `localpoints` */
-    FT_UShort*  local_points_buf;
 
-    FT_Fixed*  deltas_x       = NULL;
-    FT_Fixed*  deltas_y       = NULL;
-    /* scratch buffer pool for `deltas_x` */
-    FT_Fixed*  deltas_x_buf;
-    /* scratch buffer pool for `deltas_y` */
-    FT_Fixed*  deltas_y_buf;
-    FT_Fixed*  point_deltas_x = NULL;
-    FT_Fixed*  point_deltas_y = NULL;
+      FT_TRACE7(( "    point deltas:\n" ));
 
-    FT_Fixed*  tupleScalars;
+      /* this means that there are deltas for every point in the glyph */
+      ft_var_accumulate_deltas( point_deltas_x, deltas_x, n_points, apply );
+      ft_var_accumulate_deltas( point_deltas_y, deltas_y, n_points, apply );
 
+#ifdef FT_DEBUG_LEVEL_TRACE
+      for ( j = 0; j < n_points; j++ )
+      {
+        FT_Fixed  point_delta_x = GX_SCALE_DELTA( deltas_x[j], apply );
+        FT_Fixed  point_delta_y = GX_SCALE_DELTA( deltas_y[j], apply );
 
-    for ( i = 0; i < n_points; i++ )
-    {
-      unrounded[i].x = INT_TO_F26DOT6( outline->points[i].x );
-      unrounded[i].y = INT_TO_F26DOT6( outline->points[i].y );
-    }
 
-    if ( !face->doblend  )
-      goto Exit;
+        if ( point_delta_x || point_delta_y )
+        {
+          FT_TRACE7(( "      %u: (%f, %f) -> (%f, %f)\n",
+                      j,
+                      (double)( FT_intToFixed( outline->points[j].x ) +
+                                  point_deltas_x[j] - point_delta_x ) /
+                        65536,
+                      (double)( FT_intToFixed( outline->points[j].y ) +
+                                  point_deltas_y[j] - point_delta_y ) /
+                        65536,
+                      (double)( FT_intToFixed( outline->points[j].x ) +
+                                  point_deltas_x[j] ) / 65536,
+                      (double)( FT_intToFixed( outline->points[j].y ) +
+                                  point_deltas_y[j] ) / 65536 ));
+          count++;
+        }
+      }
 
-    if ( !blend )
-      return FT_THROW( Invalid_Argument );
+      if ( !count )
+        FT_TRACE7(( "      none\n" ));
+#endif
+    }
 
-    if ( glyph_index >= blend->gv_glyphcnt      ||
-         blend->glyphoffsets[glyph_index] ==
-           blend->glyphoffsets[glyph_index + 1] )
+    else
     {
-      FT_TRACE2(( "TT_Vary_Apply_Glyph_Deltas:"
-                  " no variation data for glyph %u\n", glyph_index ));
-      return FT_Err_Ok;
-    }
+#ifdef FT_DEBUG_LEVEL_TRACE
+      int  count = 0;
+#endif
 
-    dataSize = blend->glyphoffsets[glyph_index + 1] -
-                 blend->glyphoffsets[glyph_index];
 
-    if ( FT_STREAM_SEEK( blend->glyphoffsets[glyph_index] ) ||
-         FT_FRAME_ENTER( dataSize )                         )
-      return error;
+      /* we have to interpolate the missing deltas similar to the */
+      /* IUP bytecode instruction                                 */
+      FT_ARRAY_ZERO( has_delta, n_points );
+      FT_ARRAY_COPY( points_out, points_org, n_points );
 
-    glyph_start = FT_Stream_FTell( stream );
+      for ( j = 0; j < point_count; j++ )
+      {
+        FT_UShort  idx = points[j];
 
-    /* each set of glyph variation data is formatted similarly to `cvar' */
 
-    tupleCount   = FT_GET_USHORT();
-    offsetToData = FT_GET_USHORT();
+        if ( idx >= n_points )
+          continue;
 
-    /* rough sanity test */
-    if ( offsetToData > dataSize                                ||
-         ( tupleCount & GX_TC_TUPLE_COUNT_MASK ) * 4 > dataSize )
-    {
-      FT_TRACE2(( "TT_Vary_Apply_Glyph_Deltas:"
-                  " invalid glyph variation array header\n" ));
+        has_delta[idx] = TRUE;
 
-      error = FT_THROW( Invalid_Table );
-      goto FExit;
-    }
+        points_out[idx].x += GX_SCALE_DELTA( deltas_x[j], apply );
+        points_out[idx].y += GX_SCALE_DELTA( deltas_y[j], apply );
+      }
 
-    offsetToData += glyph_start;
+      /* no need to handle phantom points here,      */
+      /* since solitary points can't be interpolated */
+      tt_interpolate_deltas( outline,
+                             points_out,
+                             points_org,
+                             has_delta );
 
-    /* Re-use a per-face scratch pool, grown on demand, instead of      */
-    /* allocating (and freeing) it on every glyph.  This pool is freed  */
-    /* in `tt_done_blend`.  The shared/local point-number lists are     */
-    /* carved out of it too, so it must be set up before they are read. */
-    peak_coords_size    = ALIGN_SIZE( 3 * blend->num_axis *
-                                      sizeof ( *peak_coords ) );
-    point_deltas_x_size = ALIGN_SIZE( 2 * n_points *
-                                      sizeof ( *point_deltas_x ) );
-    deltas_buf_size     = ALIGN_SIZE( 2 * n_points *
-                                      sizeof ( *deltas_x ) );
-    points_buf_size     = ALIGN_SIZE( 2 * n_points *
-                                      sizeof ( *shared_points_buf ) );
-    points_org_size     = ALIGN_SIZE( n_points * sizeof ( *points_org ) );
-    points_out_size     = ALIGN_SIZE( n_points * sizeof ( *points_out ) );
-    has_delta_size      = ALIGN_SIZE( n_points * sizeof ( *has_delta ) );
+      FT_TRACE7(( "    point deltas:\n" ));
 
-    pool_size = peak_coords_size    +
-                point_deltas_x_size +
-                deltas_buf_size     +
-                points_buf_size     +
-                points_org_size     +
-                points_out_size     +
-                has_delta_size;
+      for ( j = 0; j < n_points; j++ )
+      {
+        FT_Fixed  old_point_delta_x = point_deltas_x[j];
+        FT_Fixed  old_point_delta_y = point_deltas_y[j];
 
-    if ( pool_size > blend->glyph_delta_pool_size )
-    {
-      if ( FT_QREALLOC( blend->glyph_delta_pool,
-                        blend->glyph_delta_pool_size,
-                        pool_size ) )
-        goto Exit;
-      blend->glyph_delta_pool_size = pool_size;
-    }
-    pool = blend->glyph_delta_pool;
+        FT_Pos  point_delta_x = points_out[j].x - points_org[j].x;
+        FT_Pos  point_delta_y = points_out[j].y - points_org[j].y;
 
-    p                  = pool;
-    peak_coords        = (FT_Fixed*)p;
-    p                 += peak_coords_size;
-    point_deltas_x     = (FT_Fixed*)p;
-    p                 += point_deltas_x_size;
-    deltas_x_buf       = (FT_Fixed*)p;
-    p                 += deltas_buf_size;
-    shared_points_buf  = (FT_UShort*)p;
-    p                 += points_buf_size;
-    points_org         = (FT_Vector*)p;
-    p                 += points_org_size;
-    points_out         = (FT_Vector*)p;
-    p                 += points_out_size;
-    has_delta          = (FT_Bool*)p;
 
-    FT_ARRAY_ZERO( point_deltas_x, 2 * n_points );
+        point_deltas_x[j] = old_point_delta_x + point_delta_x;
+        point_deltas_y[j] = old_point_delta_y + point_delta_y;
 
-    im_start_coords  = peak_coords + blend->num_axis;
-    im_end_coords    = im_start_coords + blend->num_axis;
-    point_deltas_y   = point_deltas_x + n_points;
-    deltas_y_buf     = deltas_x_buf + n_points;
-    local_points_buf = shared_points_buf + n_points;
+#ifdef FT_DEBUG_LEVEL_TRACE
+        if ( point_delta_x || point_delta_y )
+        {
+          FT_TRACE7(( "      %u: (%f, %f) -> (%f, %f)\n",
+                      j,
+                      (double)( FT_intToFixed( outline->points[j].x ) +
+                                  old_point_delta_x ) / 65536,
+                      (double)( FT_intToFixed( outline->points[j].y ) +
+                                  old_point_delta_y ) / 65536,
+                      (double)( FT_intToFixed( outline->points[j].x ) +
+                                  point_deltas_x[j] ) / 65536,
+                      (double)( FT_intToFixed( outline->points[j].y ) +
+                                  point_deltas_y[j] ) / 65536 ));
+          count++;
+        }
+#endif
+      }
 
-    for ( j = 0; j < n_points; j++ )
-    {
-      points_org[j].x = FT_intToFixed( outline->points[j].x );
-      points_org[j].y = FT_intToFixed( outline->points[j].y );
+#ifdef FT_DEBUG_LEVEL_TRACE
+      if ( !count )
+        FT_TRACE7(( "      none\n" ));
+#endif
     }
+  }
 
-    if ( tupleCount & GX_TC_TUPLES_SHARE_POINT_NUMBERS )
-    {
-      here = FT_Stream_FTell( stream );
 
-      FT_Stream_SeekSet( stream, offsetToData );
+  /* Remove `entry' from the LRU list of `cache'. */
+  static void
+  ft_var_unlink_glyph_var( GX_GlyphVarCache  cache,
+                           GX_GlyphVar       entry )
+  {
+    if ( entry->prev )
+      entry->prev->next = entry->next;
+    else
+      cache->head = entry->next;
 
-      sharedpoints = ft_var_readpackedpoints( stream, &spoint_count,
-                                              shared_points_buf, n_points );
+    if ( entry->next )
+      entry->next->prev = entry->prev;
+    else
+      cache->tail = entry->prev;
 
-      offsetToData = FT_Stream_FTell( stream );
+    entry->prev = NULL;
+    entry->next = NULL;
+  }
+
+
+  /* Insert `entry' at the head of the LRU list of `cache'. */
+  static void
+  ft_var_link_glyph_var( GX_GlyphVarCache  cache,
+                         GX_GlyphVar       entry )
+  {
+    entry->prev = NULL;
+    entry->next = cache->head;
+
+    if ( cache->head )
+      cache->head->prev = entry;
+    else
+      cache->tail = entry;
+
+    cache->head = entry;
+  }
+
+
+  /* Remove `entry' from `cache' and free it. */
+  static void
+  ft_var_remove_glyph_var( FT_Memory         memory,
+                           GX_GlyphVarCache  cache,
+                           GX_GlyphVar       entry )
+  {
+    ft_var_unlink_glyph_var( cache, entry );
+
+    cache->glyphs[entry->glyph_index] = NULL;
+    cache->num_bytes                 -= entry->num_bytes;
+
+    FT_FREE( entry );
+  }
+
+
+  /* Free the glyph variation cache. */
+  static void
+  ft_var_done_glyph_var_cache( FT_Memory         memory,
+                               GX_GlyphVarCache  cache )
+  {
+    while ( cache->head )
+      ft_var_remove_glyph_var( memory, cache, cache->head );
+
+    FT_FREE( cache->glyphs );
+    cache->num_bytes = 0;
+  }
+
+
+  /* Look up the decoded `gvar' data of a glyph; a found */
+  /* entry becomes the most recently used one.           */
+  static GX_GlyphVar
+  ft_var_get_glyph_var( GX_Blend  blend,
+                        FT_UInt   glyph_index,
+                        FT_UInt   n_points )
+  {
+    GX_GlyphVarCache  cache = &blend->glyph_var_cache;
+    GX_GlyphVar       entry;
+
+
+    if ( !cache->glyphs || glyph_index >= blend->gv_glyphcnt )
+      return NULL;
+
+    entry = cache->glyphs[glyph_index];
+    if ( !entry || entry->n_points != n_points )
+      return NULL;
+
+    if ( entry != cache->head )
+    {
+      ft_var_unlink_glyph_var( cache, entry );
+      ft_var_link_glyph_var( cache, entry );
+    }
+
+    return entry;
+  }
+
+
+  /* Add a new entry to the glyph variation cache, discarding the least */
+  /* recently used entries as necessary to stay within the memory limit */
+  /* set with the `gvar-cache-size' property.  Return FALSE if `entry'  */
+  /* cannot be added; the caller must then free it.                     */
+  static FT_Bool
+  ft_var_add_glyph_var( TT_Face      face,
+                        GX_GlyphVar  entry )
+  {
+    FT_Memory         memory = face->root.memory;
+    TT_Driver         driver = (TT_Driver)FT_FACE_DRIVER( face );
+    GX_Blend          blend  = face->blend;
+    GX_GlyphVarCache  cache  = &blend->glyph_var_cache;
+    FT_ULong          glyphs_size;
+    FT_Error          error;
+
+
+    glyphs_size = blend->gv_glyphcnt * sizeof ( GX_GlyphVar );
+
+    if ( entry->glyph_index >= blend->gv_glyphcnt               ||
+         glyphs_size + entry->num_bytes > driver->gvar_cache_size )
+      return FALSE;
+
+    if ( !cache->glyphs )
+    {
+      if ( FT_NEW_ARRAY( cache->glyphs, blend->gv_glyphcnt ) )
+        return FALSE;
+
+      cache->num_bytes = glyphs_size;
+    }
+
+    /* an entry decoded for a different number of points */
+    if ( cache->glyphs[entry->glyph_index] )
+      ft_var_remove_glyph_var( memory,
+                               cache,
+                               cache->glyphs[entry->glyph_index] );
+
+    while ( cache->tail                                              &&
+            cache->num_bytes + entry->num_bytes > driver->gvar_cache_size )
+      ft_var_remove_glyph_var( memory, cache, cache->tail );
+
+    ft_var_link_glyph_var( cache, entry );
+
+    cache->glyphs[entry->glyph_index] = entry;
+    cache->num_bytes                 += entry->num_bytes;
+
+    return TRUE;
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   ft_var_load_glyph_var
+   *
+   * @Description:
+   *   Decode the tuple variation headers, point numbers, and deltas of a
+   *   glyph's `gvar' data, independently of the current design
+   *   coordinates.  Tuples whose point numbers or deltas can't be read are
+   *   ignored, exactly as in `TT_Vary_Apply_Glyph_Deltas'.
+   *
+   *   The data is read in two passes; the first one only determines the
+   *   size of the entry so that everything fits into a single block.
+   *
+   * @Input:
+   *   face ::
+   *     The font face.
+   *
+   *   glyph_index ::
+   *     The glyph index.
+   *
+   *   n_points ::
+   *     The number of outline points, including the phantom points.
+   *
+   *   points_buf ::
+   *     A scratch buffer for `2 * n_points' point numbers.
+   *
+   * @Output:
+   *   aentry ::
+   *     The new entry.  It must be either added to the cache with
+   *     `ft_var_add_glyph_var' or freed by the caller.
+   *
+   * @Return:
+   *   FreeType error code.  0 means success.
+   */
+  static FT_Error
+  ft_var_load_glyph_var( TT_Face       face,
+                         FT_UInt       glyph_index,
+                         FT_UInt       n_points,
+                         FT_UShort*    points_buf,
+                         GX_GlyphVar  *aentry )
+  {
+    FT_Error   error;
+    FT_Stream  stream   = face->root.stream;
+    FT_Memory  memory   = stream->memory;
+    GX_Blend   blend    = face->blend;
+    FT_UInt    num_axis = blend->num_axis;
+
+    FT_ULong  dataSize;
+    FT_ULong  glyph_start;
+    FT_ULong  offsetToData;
+    FT_ULong  dataOffset;
+    FT_ULong  here;
+    FT_UInt   tupleCount;
+    FT_UInt   i, j, pass;
+    FT_Byte*  headers;
+    FT_Byte*  p;
+
+    FT_UShort*  sharedpoints = NULL;
+    FT_UShort*  shared_copy  = NULL;
+    FT_UInt     spoint_count = 0;
+
+    FT_UInt     num_tuples = 0;
+    FT_ULong    num_coords = 0;
+    FT_ULong    num_deltas = 0;
+    FT_ULong    num_points = 0;
+    FT_ULong    size;
+    FT_Fixed*   coord_data = NULL;
+    FT_Short*   delta_data = NULL;
+    FT_UShort*  point_data = NULL;
+
+    GX_GlyphVar  entry = NULL;
+
+
+    *aentry = NULL;
+
+    dataSize = blend->glyphoffsets[glyph_index + 1] -
+                 blend->glyphoffsets[glyph_index];
+
+    if ( FT_STREAM_SEEK( blend->glyphoffsets[glyph_index] ) ||
+         FT_FRAME_ENTER( dataSize )                         )
+      return error;
+
+    glyph_start = FT_Stream_FTell( stream );
+
+    tupleCount   = FT_GET_USHORT();
+    offsetToData = FT_GET_USHORT();
+
+    /* rough sanity test */
+    if ( offsetToData > dataSize                                ||
+         ( tupleCount & GX_TC_TUPLE_COUNT_MASK ) * 4 > dataSize )
+    {
+      FT_TRACE2(( "ft_var_load_glyph_var:"
+                  " invalid glyph variation array header\n" ));
+
+      error = FT_THROW( Invalid_Table );
+      goto Exit;
+    }
+
+    offsetToData += glyph_start;
+
+    if ( tupleCount & GX_TC_TUPLES_SHARE_POINT_NUMBERS )
+    {
+      here = FT_Stream_FTell( stream );
+
+      FT_Stream_SeekSet( stream, offsetToData );
+
+      sharedpoints = ft_var_readpackedpoints( stream, &spoint_count,
+                                              points_buf, n_points );
+
+      offsetToData = FT_Stream_FTell( stream );
+
+      FT_Stream_SeekSet( stream, here );
+
+      if ( sharedpoints && sharedpoints != ALL_POINTS )
+        num_points += spoint_count;
+    }
+
+    headers     = stream->cursor;
+    tupleCount &= GX_TC_TUPLE_COUNT_MASK;
+
+    /* see `TT_Vary_Apply_Glyph_Deltas' for the bounds checks */
+    if ( 4 * tupleCount > (FT_UInt)( stream->limit - headers ) )
+    {
+      FT_TRACE2(( "ft_var_load_glyph_var:"
+                  " invalid glyph variation array header\n" ));
+      error = FT_THROW( Invalid_Table );
+      goto Exit;
+    }
+
+    for ( pass = 0; pass < 2; pass++ )
+    {
+      p          = headers;
+      dataOffset = offsetToData;
+
+      for ( i = 0; i < tupleCount; i++ )
+      {
+        FT_UInt     tupleDataSize;
+        FT_UInt     tupleIndex;
+        FT_Byte*    peak_p = NULL;
+        FT_Byte*    im_p   = NULL;
+        FT_UShort*  points;
+        FT_UInt     point_count;
+        FT_UInt     delta_count;
+
+
+        tupleDataSize = FT_NEXT_USHORT( p );
+        tupleIndex    = FT_NEXT_USHORT( p );
+
+        if ( tupleIndex & GX_TI_EMBEDDED_TUPLE_COORD )
+        {
+          if ( 2 * num_axis + 4 * ( tupleCount - i - 1 ) >
+                 (FT_UInt)( stream->limit - p ) )
+          {
+            FT_TRACE2(( "ft_var_load_glyph_var:"
+                        " invalid glyph variation array header\n" ));
+            error = FT_THROW( Invalid_Table );
+            goto Exit;
+          }
+
+          peak_p = p;
+          p     += 2 * num_axis;
+        }
+        else if ( ( tupleIndex & GX_TI_TUPLE_INDEX_MASK ) >=
+                    blend->tuplecount                        )
+        {
+          FT_TRACE2(( "ft_var_load_glyph_var:"
+                      " invalid tuple index\n" ));
+
+          error = FT_THROW( Invalid_Table );
+          goto Exit;
+        }
+
+        if ( tupleIndex & GX_TI_INTERMEDIATE_TUPLE )
+        {
+          if ( 4 * num_axis + 4 * ( tupleCount - i - 1 ) >
+                 (FT_UInt)( stream->limit - p ) )
+          {
+            FT_TRACE2(( "ft_var_load_glyph_var:"
+                        " invalid glyph variation array header\n" ));
+            error = FT_THROW( Invalid_Table );
+            goto Exit;
+          }
+
+          im_p = p;
+          p   += 4 * num_axis;
+        }
+
+        FT_Stream_SeekSet( stream, dataOffset );
+        dataOffset += tupleDataSize;
+
+        if ( tupleIndex & GX_TI_PRIVATE_POINT_NUMBERS )
+          points = ft_var_readpackedpoints( stream, &point_count,
+                                            points_buf + n_points,
+                                            n_points );
+        else
+        {
+          points      = sharedpoints;
+          point_count = spoint_count;
+        }
+
+        if ( !points )
+          continue; /* failure, ignore it */
+
+        delta_count = point_count == 0 ? n_points : point_count;
+
+        if ( pass == 0 )
+        {
+          num_tuples++;
+          num_deltas += 2 * delta_count;
+          if ( peak_p )
+            num_coords += num_axis;
+          if ( im_p )
+            num_coords += 2 * num_axis;
+          if ( points != ALL_POINTS && points != sharedpoints )
+            num_points += point_count;
+        }
+        else
+        {
+          GX_GlyphTuple  tuple = entry->tuples + entry->num_tuples;
+
+
+          /* the deltas are read directly into the entry */
+          if ( ft_var_readpackeddeltas( stream, delta_count,
+                                        delta_data,
+                                        delta_count )              &&
+               ft_var_readpackeddeltas( stream, delta_count,
+                                        delta_data + delta_count,
+                                        delta_count )              )
+          {
+            tuple->tuple_index = (FT_UShort)tupleIndex;
+            tuple->point_count = delta_count;
+            tuple->deltas_x    = delta_data;
+            tuple->deltas_y    = delta_data + delta_count;
+            delta_data        += 2 * delta_count;
+
+            if ( points == ALL_POINTS )
+              tuple->points = NULL;
+            else if ( points == sharedpoints )
+              tuple->points = shared_copy;
+            else
+            {
+              FT_ARRAY_COPY( point_data, points, point_count );
+              tuple->points = point_data;
+              point_data   += point_count;
+            }
+
+            tuple->peak_coords     = NULL;
+            tuple->im_start_coords = NULL;
+            tuple->im_end_coords   = NULL;
+
+            if ( peak_p )
+            {
+              tuple->peak_coords = coord_data;
+              for ( j = 0; j < num_axis; j++ )
+                *coord_data++ = FT_fdot14ToFixed( FT_NEXT_SHORT( peak_p ) );
+            }
+
+            if ( im_p )
+            {
+              tuple->im_start_coords = coord_data;
+              tuple->im_end_coords   = coord_data + num_axis;
+              for ( j = 0; j < 2 * num_axis; j++ )
+                *coord_data++ = FT_fdot14ToFixed( FT_NEXT_SHORT( im_p ) );
+            }
+
+            entry->num_tuples++;
+          }
+        }
+
+        if ( points != ALL_POINTS                  &&
+             points != sharedpoints                &&
+             points != points_buf + n_points       )
+          FT_FREE( points );
+      }
+
+      if ( pass == 0 )
+      {
+        size = sizeof ( GX_GlyphVarRec )                 +
+               num_tuples * sizeof ( GX_GlyphTupleRec ) +
+               num_coords * sizeof ( FT_Fixed )         +
+               num_deltas * sizeof ( FT_Short )         +
+               num_points * sizeof ( FT_UShort );
+
+        if ( FT_QALLOC( entry, size ) )
+          goto Exit;
+
+        entry->prev        = NULL;
+        entry->next        = NULL;
+        entry->glyph_index = glyph_index;
+        entry->n_points    = n_points;
+        entry->num_bytes   = size;
+        entry->num_tuples  = 0;
+        entry->tuples      = (GX_GlyphTuple)( entry + 1 );
+
+        coord_data = (FT_Fixed*)( entry->tuples + num_tuples );
+        delta_data = (FT_Short*)( coord_data + num_coords );
+        point_data = (FT_UShort*)( delta_data + num_deltas );
+
+        if ( sharedpoints && sharedpoints != ALL_POINTS )
+        {
+          FT_ARRAY_COPY( point_data, sharedpoints, spoint_count );
+          shared_copy = point_data;
+          point_data += spoint_count;
+        }
+      }
+    }
+
+    *aentry = entry;
+    entry   = NULL;
+
+  Exit:
+    FT_FREE( entry );
+
+    if ( sharedpoints != ALL_POINTS && sharedpoints != points_buf )
+      FT_FREE( sharedpoints );
+
+    FT_FRAME_EXIT();
+
+    return error;
+  }
+
+
+  /* Return the scalar of a cached tuple for the current design   */
+  /* coordinates, using (and filling) the shared tuple scalars the */
+  /* same way as `TT_Vary_Apply_Glyph_Deltas'.                     */
+  static FT_Fixed
+  ft_var_get_glyph_tuple_scalar( GX_Blend       blend,
+                                 GX_GlyphTuple  tuple )
+  {
+    FT_UInt    tupleIndex = tuple->tuple_index;
+    FT_UInt    k          = tupleIndex & GX_TI_TUPLE_INDEX_MASK;
+    FT_Bool    is_shared;
+    FT_Fixed*  tuple_coords;
+    FT_Fixed   apply;
+
+
+    /* see the fast path for shared tuples in `TT_Vary_Apply_Glyph_Deltas' */
+    is_shared = FT_BOOL( ( tupleIndex & ~GX_TI_PRIVATE_POINT_NUMBERS ) <
+                           blend->tuplecount );
+
+    if ( is_shared && blend->tuplescalars[k] != (FT_Fixed)-0x20000 )
+      return blend->tuplescalars[k];
+
+    tuple_coords = tuple->peak_coords
+                     ? tuple->peak_coords
+                     : blend->tuplecoords + k * blend->num_axis;
+
+    apply = ft_var_apply_tuple( blend,
+                                (FT_UShort)tupleIndex,
+                                tuple_coords,
+                                tuple->im_start_coords,
+                                tuple->im_end_coords );
+
+    if ( is_shared )
+      blend->tuplescalars[k] = apply;
+
+    return apply;
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   TT_Vary_Apply_Glyph_Deltas
+   *
+   * @Description:
+   *   Apply the appropriate deltas to the current glyph.
+   *
+   * @InOut:
+   *   loader ::
+   *     A handle to the loader object.
+   *
+   *   outline ::
+   *     The outline to change, with appended phantom points.
+   *
+   * @Output:
+   *   unrounded ::
+   *     An array with `n_points' elements that is filled with unrounded
+   *     point coordinates (in 26.6 format).
+   *
+   * @Return:
+   *   FreeType error code.  0 means success.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Vary_Apply_Glyph_Deltas( TT_Loader    loader,
+                              FT_Outline*  outline,
+                              FT_Vector*   unrounded )
+  {
+    FT_Error   error       = FT_Err_Ok;
+    TT_Face    face        = loader->face;
+    FT_Stream  stream      = face->root.stream;
+    FT_Memory  memory      = stream->memory;
+    FT_UInt    glyph_index = loader->glyph_index;
+    FT_UInt    n_points    = (FT_UInt)outline->n_points + 4;
+
+    FT_Vector*  points_org = NULL;  /* coordinates in 16.16 format */
+    FT_Vector*  points_out = NULL;  /* coordinates in 16.16 format */
+    FT_Bool*    has_delta  = NULL;
+
+    TT_Driver  driver       = (TT_Driver)FT_FACE_DRIVER( face );
+    FT_Bool    opened_frame = 0;
+
+    FT_ULong  glyph_start;
+
+    FT_UInt   tupleCount;
+    FT_ULong  offsetToData;
+    FT_ULong  dataSize;
+
+    FT_ULong  here;
+    FT_UInt   i, j;
+
+    FT_UInt   peak_coords_size;
+    FT_UInt   point_deltas_x_size;
+    FT_UInt   deltas_buf_size;
+    FT_UInt   points_buf_size;
+    FT_UInt   points_org_size;
+    FT_UInt   points_out_size;
+    FT_UInt   has_delta_size;
+    FT_UInt   pool_size;
+    FT_Byte*  pool = NULL;
+    FT_Byte*  p;
+
+    FT_Fixed*  peak_coords = NULL;
+    FT_Fixed*  tuple_coords;
+    FT_Fixed*  im_start_coords;
+    FT_Fixed*  im_end_coords;
+
+    GX_Blend  blend = face->blend;
+
+    FT_UInt  point_count;
+    FT_UInt  spoint_count = 0;
+
+    FT_UShort*  sharedpoints      = NULL;
+    FT_UShort*  localpoints       = NULL;
+    FT_UShort*  points;
+    /* scratch buffer pool for `sharedpoints` */
+    FT_UShort*  shared_points_buf = NULL;
+    /* scratch buffer pool for `localpoints` */
+    FT_UShort*  local_points_buf;
+
+    FT_Short*  deltas_x       = NULL;
+    FT_Short*  deltas_y       = NULL;
+    /* scratch buffer pool for `deltas_x` */
+    FT_Short*  deltas_x_buf;
+    /* scratch buffer pool for `deltas_y` */
+    FT_Short*  deltas_y_buf;
+    FT_Fixed*  point_deltas_x = NULL;
+    FT_Fixed*  point_deltas_y = NULL;
+
+    FT_Fixed*  tupleScalars;
+
+
+    for ( i = 0; i < n_points; i++ )
+    {
+      unrounded[i].x = INT_TO_F26DOT6( outline->points[i].x );
+      unrounded[i].y = INT_TO_F26DOT6( outline->points[i].y );
+    }
+
+    if ( !face->doblend  )
+      goto Exit;
+
+    if ( !blend )
+      return FT_THROW( Invalid_Argument );
+
+    if ( glyph_index >= blend->gv_glyphcnt      ||
+         blend->glyphoffsets[glyph_index] ==
+           blend->glyphoffsets[glyph_index + 1] )
+    {
+      FT_TRACE2(( "TT_Vary_Apply_Glyph_Deltas:"
+                  " no variation data for glyph %u\n", glyph_index ));
+      return FT_Err_Ok;
+    }
+
+    /* Re-use a per-face scratch pool, grown on demand, instead of      */
+    /* allocating (and freeing) it on every glyph.  This pool is freed  */
+    /* in `tt_done_blend`.  The shared/local point-number lists are     */
+    /* carved out of it too, so it must be set up before they are read. */
+    peak_coords_size    = ALIGN_SIZE( 3 * blend->num_axis *
+                                      sizeof ( *peak_coords ) );
+    point_deltas_x_size = ALIGN_SIZE( 2 * n_points *
+                                      sizeof ( *point_deltas_x ) );
+    deltas_buf_size     = ALIGN_SIZE( 2 * n_points *
+                                      sizeof ( *deltas_x ) );
+    points_buf_size     = ALIGN_SIZE( 2 * n_points *
+                                      sizeof ( *shared_points_buf ) );
+    points_org_size     = ALIGN_SIZE( n_points * sizeof ( *points_org ) );
+    points_out_size     = ALIGN_SIZE( n_points * sizeof ( *points_out ) );
+    has_delta_size      = ALIGN_SIZE( n_points * sizeof ( *has_delta ) );
+
+    pool_size = peak_coords_size    +
+                point_deltas_x_size +
+                deltas_buf_size     +
+                points_buf_size     +
+                points_org_size     +
+                points_out_size     +
+                has_delta_size;
+
+    if ( pool_size > blend->glyph_delta_pool_size )
+    {
+      if ( FT_QREALLOC( blend->glyph_delta_pool,
+                        blend->glyph_delta_pool_size,
+                        pool_size ) )
+        goto Exit;
+      blend->glyph_delta_pool_size = pool_size;
+    }
+    pool = blend->glyph_delta_pool;
+
+    p                  = pool;
+    peak_coords        = (FT_Fixed*)p;
+    p                 += peak_coords_size;
+    point_deltas_x     = (FT_Fixed*)p;
+    p                 += point_deltas_x_size;
+    deltas_x_buf       = (FT_Short*)p;
+    p                 += deltas_buf_size;
+    shared_points_buf  = (FT_UShort*)p;
+    p                 += points_buf_size;
+    points_org         = (FT_Vector*)p;
+    p                 += points_org_size;
+    points_out         = (FT_Vector*)p;
+    p                 += points_out_size;
+    has_delta          = (FT_Bool*)p;
+
+    FT_ARRAY_ZERO( point_deltas_x, 2 * n_points );
+
+    im_start_coords  = peak_coords + blend->num_axis;
+    im_end_coords    = im_start_coords + blend->num_axis;
+    point_deltas_y   = point_deltas_x + n_points;
+    deltas_y_buf     = deltas_x_buf + n_points;
+    local_points_buf = shared_points_buf + n_points;
+
+    for ( j = 0; j < n_points; j++ )
+    {
+      points_org[j].x = FT_intToFixed( outline->points[j].x );
+      points_org[j].y = FT_intToFixed( outline->points[j].y );
+    }
+
+    /* With the glyph variation cache, only the tuple scalars must be */
+    /* computed; the packed `gvar' data is decoded once per glyph.    */
+    if ( driver->gvar_cache_size )
+    {
+      GX_GlyphVar  entry  = ft_var_get_glyph_var( blend,
+                                                  glyph_index,
+                                                  n_points );
+      FT_Bool      is_new = FALSE;
+
+
+      if ( !entry )
+      {
+        error = ft_var_load_glyph_var( face,
+                                       glyph_index,
+                                       n_points,
+                                       shared_points_buf,
+                                       &entry );
+        if ( error )
+          goto Exit;
+
+        is_new = TRUE;
+      }
+
+      FT_TRACE5(( "gvar: there %s %u cached tuple%s:\n",
+                  entry->num_tuples == 1 ? "is" : "are",
+                  entry->num_tuples,
+                  entry->num_tuples == 1 ? "" : "s" ));
+
+      for ( i = 0; i < entry->num_tuples; i++ )
+      {
+        GX_GlyphTuple  tuple = entry->tuples + i;
+        FT_Fixed       apply;
+
+
+        FT_TRACE6(( "  tuple %u:\n", i ));
+
+        apply = ft_var_get_glyph_tuple_scalar( blend, tuple );
+
+        if ( apply == 0 )              /* tuple isn't active for our blend */
+          continue;
+
+        ft_var_apply_glyph_tuple( outline,
+                                  n_points,
+                                  apply,
+                                  tuple->points ? tuple->points
+                                                : ALL_POINTS,
+                                  tuple->point_count,
+                                  tuple->deltas_x,
+                                  tuple->deltas_y,
+                                  points_org,
+                                  points_out,
+                                  has_delta,
+                                  point_deltas_x,
+                                  point_deltas_y );
+      }
+
+      if ( is_new && !ft_var_add_glyph_var( face, entry ) )
+        FT_FREE( entry );
+
+      goto Apply_Deltas;
+    }
+
+    dataSize = blend->glyphoffsets[glyph_index + 1] -
+                 blend->glyphoffsets[glyph_index];
+
+    if ( FT_STREAM_SEEK( blend->glyphoffsets[glyph_index] ) ||
+         FT_FRAME_ENTER( dataSize )                         )
+      goto Exit;
+
+    opened_frame = 1;
+
+    glyph_start = FT_Stream_FTell( stream );
+
+    /* each set of glyph variation data is formatted similarly to `cvar' */
+
+    tupleCount   = FT_GET_USHORT();
+    offsetToData = FT_GET_USHORT();
+
+    /* rough sanity test */
+    if ( offsetToData > dataSize                                ||
+         ( tupleCount & GX_TC_TUPLE_COUNT_MASK ) * 4 > dataSize )
+    {
+      FT_TRACE2(( "TT_Vary_Apply_Glyph_Deltas:"
+                  " invalid glyph variation array header\n" ));
+
+      error = FT_THROW( Invalid_Table );
+      goto Exit;
+    }
+
+    offsetToData += glyph_start;
+
+    if ( tupleCount & GX_TC_TUPLES_SHARE_POINT_NUMBERS )
+    {
+      here = FT_Stream_FTell( stream );
+
+      FT_Stream_SeekSet( stream, offsetToData );
+
+      sharedpoints = ft_var_readpackedpoints( stream, &spoint_count,
+                                              shared_points_buf, n_points );
+
+      offsetToData = FT_Stream_FTell( stream );
 
       FT_Stream_SeekSet( stream, here );
     }
@@ -4703,125 +5426,19 @@
       if ( !points || !deltas_y || !deltas_x )
         ; /* failure, ignore it */
 
-      else if ( points == ALL_POINTS )
-      {
-#ifdef FT_DEBUG_LEVEL_TRACE
-        int  count = 0;
-#endif
-
-
-        FT_TRACE7(( "    point deltas:\n" ));
-
-        /* this means that there are deltas for every point in the glyph */
-        for ( j = 0; j < n_points; j++ )
-        {
-          FT_Fixed  old_point_delta_x = point_deltas_x[j];
-          FT_Fixed  old_point_delta_y = point_deltas_y[j];
-
-          FT_Fixed  point_delta_x = FT_MulFix( deltas_x[j], apply );
-          FT_Fixed  point_delta_y = FT_MulFix( deltas_y[j], apply );
-
-
-          point_deltas_x[j] = old_point_delta_x + point_delta_x;
-          point_deltas_y[j] = old_point_delta_y + point_delta_y;
-
-#ifdef FT_DEBUG_LEVEL_TRACE
-          if ( point_delta_x || point_delta_y )
-          {
-            FT_TRACE7(( "      %u: (%f, %f) -> (%f, %f)\n",
-                        j,
-                        (double)( FT_intToFixed( outline->points[j].x ) +
-                                    old_point_delta_x ) / 65536,
-                        (double)( FT_intToFixed( outline->points[j].y ) +
-                                    old_point_delta_y ) / 65536,
-                        (double)( FT_intToFixed( outline->points[j].x ) +
-                                    point_deltas_x[j] ) / 65536,
-                        (double)( FT_intToFixed( outline->points[j].y ) +
-                                    point_deltas_y[j] ) / 65536 ));
-            count++;
-          }
-#endif
-        }
-
-#ifdef FT_DEBUG_LEVEL_TRACE
-        if ( !count )
-          FT_TRACE7(( "      none\n" ));
-#endif
-      }
-
       else
-      {
-#ifdef FT_DEBUG_LEVEL_TRACE
-        int  count = 0;
-#endif
-
-
-        /* we have to interpolate the missing deltas similar to the */
-        /* IUP bytecode instruction                                 */
-        for ( j = 0; j < n_points; j++ )
-        {
-          has_delta[j]  = FALSE;
-          points_out[j] = points_org[j];
-        }
-
-        for ( j = 0; j < point_count; j++ )
-        {
-          FT_UShort  idx = points[j];
-
-
-          if ( idx >= n_points )
-            continue;
-
-          has_delta[idx] = TRUE;
-
-          points_out[idx].x += FT_MulFix( deltas_x[j], apply );
-          points_out[idx].y += FT_MulFix( deltas_y[j], apply );
-        }
-
-        /* no need to handle phantom points here,      */
-        /* since solitary points can't be interpolated */
-        tt_interpolate_deltas( outline,
-                               points_out,
-                               points_org,
-                               has_delta );
-
-        FT_TRACE7(( "    point deltas:\n" ));
-
-        for ( j = 0; j < n_points; j++ )
-        {
-          FT_Fixed  old_point_delta_x = point_deltas_x[j];
-          FT_Fixed  old_point_delta_y = point_deltas_y[j];
-
-          FT_Pos  point_delta_x = points_out[j].x - points_org[j].x;
-          FT_Pos  point_delta_y = points_out[j].y - points_org[j].y;
-
-
-          point_deltas_x[j] = old_point_delta_x + point_delta_x;
-          point_deltas_y[j] = old_point_delta_y + point_delta_y;
-
-#ifdef FT_DEBUG_LEVEL_TRACE
-          if ( point_delta_x || point_delta_y )
-          {
-            FT_TRACE7(( "      %u: (%f, %f) -> (%f, %f)\n",
-                        j,
-                        (double)( FT_intToFixed( outline->points[j].x ) +
-                                    old_point_delta_x ) / 65536,
-                        (double)( FT_intToFixed( outline->points[j].y ) +
-                                    old_point_delta_y ) / 65536,
-                        (double)( FT_intToFixed( outline->points[j].x ) +
-                                    point_deltas_x[j] ) / 65536,
-                        (double)( FT_intToFixed( outline->points[j].y ) +
-                                    point_deltas_y[j] ) / 65536 ));
-            count++;
-          }
-#endif
-        }
-
-#ifdef FT_DEBUG_LEVEL_TRACE
-        if ( !count )
-          FT_TRACE7(( "      none\n" ));
-#endif
-      }
+        ft_var_apply_glyph_tuple( outline,
+                                  n_points,
+                                  apply,
+                                  points,
+                                  point_count,
+                                  deltas_x,
+                                  deltas_y,
+                                  points_org,
+                                  points_out,
+                                  has_delta,
+                                  point_deltas_x,
+                                  point_deltas_y );
 
       /* Only free deltas that fell back to a heap allocation; */
       /* the common case reuses the pooled scratch buffers.    */
@@ -4837,6 +5454,7 @@
       FT_Stream_SeekSet( stream, here );
     }
 
+  Apply_Deltas:
     FT_TRACE5(( "\n" ));
 
     /* To avoid double adjustment of advance width or height, */
@@ -4890,13 +5508,154 @@
     /* The persistent per-face scratch buffer (`blend->glyph_delta_pool`) */
     /* is freed in `tt_done_blend`, not here.                             */
 
-  FExit:
-    FT_FRAME_EXIT();
+    if ( opened_frame )
+      FT_FRAME_EXIT();
 
     return error;
   }
 
 
+  /**************************************************************************
+   *
+   * @Function:
+   *   TT_Vary_Get_HAdvance
+   *
+   * @Description:
+   *   Compute the advance width of a glyph for the current design
+   *   coordinates by applying the `gvar' deltas of its horizontal phantom
+   *   points only, without loading the outline.  The result is identical
+   *   to the linear advance width computed by `TT_Vary_Apply_Glyph_Deltas'
+   *   for fonts without an `HVAR' table.
+   *
+   * @Input:
+   *   face ::
+   *     The font face.
+   *
+   *   glyph_index ::
+   *     The glyph index.
+   *
+   *   n_points ::
+   *     The number of outline points (for a simple glyph) or components
+   *     (for a composite glyph), not including the phantom points.
+   *
+   *   advance ::
+   *     The glyph's advance width from the `hmtx' table.
+   *
+   * @InOut:
+   *   alinear ::
+   *     The varied advance width in font units.  It is left unchanged if
+   *     the glyph has no variation data.
+   *
+   * @Return:
+   *   FreeType error code.  0 means success.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Vary_Get_HAdvance( TT_Face    face,
+                        FT_UInt    glyph_index,
+                        FT_UInt    n_points,
+                        FT_UShort  advance,
+                        FT_Int*    alinear )
+  {
+    FT_Error   error  = FT_Err_Ok;
+    FT_Memory  memory = face->root.memory;
+    TT_Driver  driver = (TT_Driver)FT_FACE_DRIVER( face );
+    GX_Blend   blend  = face->blend;
+
+    GX_GlyphVar  entry  = NULL;
+    FT_Bool      is_new = FALSE;
+
+    FT_UInt   pp1 = n_points;      /* index of the first phantom point  */
+    FT_UInt   pp2 = n_points + 1;  /* index of the second phantom point */
+    FT_Fixed  delta1 = 0;
+    FT_Fixed  delta2 = 0;
+    FT_UInt   i, j;
+
+
+    /* the phantom points are not moved if there is an `HVAR' table */
+    if ( !face->doblend                                            ||
+         ( face->variation_support & TT_FACE_FLAG_VAR_HADVANCE ) )
+      return FT_Err_Ok;
+
+    if ( !blend )
+      return FT_THROW( Invalid_Argument );
+
+    if ( glyph_index >= blend->gv_glyphcnt      ||
+         blend->glyphoffsets[glyph_index] ==
+           blend->glyphoffsets[glyph_index + 1] )
+      return FT_Err_Ok;
+
+    n_points += 4;
+
+    if ( driver->gvar_cache_size )
+      entry = ft_var_get_glyph_var( blend, glyph_index, n_points );
+
+    if ( !entry )
+    {
+      FT_ULong  points_buf_size = 2 * n_points * sizeof ( FT_UShort );
+
+
+      /* the scratch pool of `TT_Vary_Apply_Glyph_Deltas' is large enough */
+      /* for the point numbers of the glyph in most cases                 */
+      if ( points_buf_size > blend->glyph_delta_pool_size )
+      {
+        if ( FT_QREALLOC( blend->glyph_delta_pool,
+                          blend->glyph_delta_pool_size,
+                          points_buf_size ) )
+          return error;
+        blend->glyph_delta_pool_size = points_buf_size;
+      }
+
+      error = ft_var_load_glyph_var( face,
+                                     glyph_index,
+                                     n_points,
+                                     (FT_UShort*)blend->glyph_delta_pool,
+                                     &entry );
+      if ( error )
+        return error;
+
+      is_new = TRUE;
+    }
+
+    for ( i = 0; i < entry->num_tuples; i++ )
+    {
+      GX_GlyphTuple  tuple = entry->tuples + i;
+      FT_Fixed       apply;
+
+
+      apply = ft_var_get_glyph_tuple_scalar( blend, tuple );
+      if ( apply == 0 )
+        continue;
+
+      if ( !tuple->points )
+      {
+        delta1 += GX_SCALE_DELTA( tuple->deltas_x[pp1], apply );
+        delta2 += GX_SCALE_DELTA( tuple->deltas_x[pp2], apply );
+      }
+      else
+      {
+        /* phantom points are never interpolated */
+        for ( j = 0; j < tuple->point_count; j++ )
+        {
+          if ( tuple->points[j] == pp1 )
+            delta1 += GX_SCALE_DELTA( tuple->deltas_x[j], apply );
+          else if ( tuple->points[j] == pp2 )
+            delta2 += GX_SCALE_DELTA( tuple->deltas_x[j], apply );
+        }
+      }
+    }
+
+    if ( is_new && !ft_var_add_glyph_var( face, entry ) )
+      FT_FREE( entry );
+
+    /* see the computation of `loader->linear' above */
+    *alinear = (FT_Int)( FT_PIX_ROUND( INT_TO_F26DOT6( advance ) +
+                                       FT_fixedToFdot6( delta2 ) -
+                                       FT_fixedToFdot6( delta1 ) ) / 64 );
+
+    return FT_Err_Ok;
+  }
+
+
   /**************************************************************************
    *
    * @Function:
@@ -4970,7 +5729,6 @@
     }
 
     FT_FREE( itemStore->regionScalars );
-    FT_FREE( itemStore->cachedCoords );
   }
 
 
@@ -5016,6 +5774,8 @@
       FT_FREE( blend->mmvar );
       FT_FREE( blend->glyph_delta_pool );
 
+      ft_var_done_glyph_var_cache( memory, &blend->glyph_var_cache );
+
       if ( blend->avar_table )
       {
         if ( blend->avar_table->avar_segment )
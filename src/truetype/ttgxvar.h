@@ -175,6 +175,141 @@ FT_BEGIN_HEADER
   } GX_MVarTableRec, *GX_MVarTable;
 
 
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   GX_GlyphTupleRec
+   *
+   * @Description:
+   *   A decoded tuple variation of a glyph's `gvar' data.  Only the
+   *   scalar of the tuple depends on the current design coordinates.
+   *
+   * @Fields:
+   *   tuple_index ::
+   *     The `tupleIndex' field of the tuple variation header, i.e., the
+   *     shared tuple index and flags.
+   *
+   *   point_count ::
+   *     The number of entries in `points', `deltas_x', and `deltas_y'.
+   *
+   *   points ::
+   *     The affected point indices, or `NULL' if the tuple covers all
+   *     points.
+   *
+   *   deltas_x ::
+   *     The horizontal deltas (in font units).
+   *
+   *   deltas_y ::
+   *     The vertical deltas (in font units).
+   *
+   *   peak_coords ::
+   *     The embedded peak coordinates, or `NULL' for a shared tuple.
+   *
+   *   im_start_coords ::
+   *     The start coordinates of an intermediate tuple.
+   *
+   *   im_end_coords ::
+   *     The end coordinates of an intermediate tuple.
+   */
+  typedef struct  GX_GlyphTupleRec_
+  {
+    FT_UShort   tuple_index;
+    FT_UInt     point_count;
+    FT_UShort*  points;
+    FT_Short*   deltas_x;
+    FT_Short*   deltas_y;
+
+    FT_Fixed*   peak_coords;
+    FT_Fixed*   im_start_coords;
+    FT_Fixed*   im_end_coords;
+
+  } GX_GlyphTupleRec, *GX_GlyphTuple;
+
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   GX_GlyphVarRec
+   *
+   * @Description:
+   *   The decoded `gvar' data of a glyph, as stored in the glyph variation
+   *   cache.  The tuple array and all tuple data directly follow the
+   *   structure in memory.
+   *
+   * @Fields:
+   *   prev ::
+   *     The previous (more recently used) entry in the cache.
+   *
+   *   next ::
+   *     The next (less recently used) entry in the cache.
+   *
+   *   glyph_index ::
+   *     The glyph index.
+   *
+   *   n_points ::
+   *     The number of outline points the data was decoded for, including
+   *     the four phantom points.
+   *
+   *   num_bytes ::
+   *     The size of the entry.
+   *
+   *   num_tuples ::
+   *     The number of valid tuple variations.
+   *
+   *   tuples ::
+   *     The tuple variations.
+   */
+  typedef struct  GX_GlyphVarRec_
+  {
+    struct GX_GlyphVarRec_*  prev;
+    struct GX_GlyphVarRec_*  next;
+
+    FT_UInt        glyph_index;
+    FT_UInt        n_points;
+    FT_ULong       num_bytes;
+
+    FT_UInt        num_tuples;
+    GX_GlyphTuple  tuples;
+
+  } GX_GlyphVarRec, *GX_GlyphVar;
+
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   GX_GlyphVarCacheRec
+   *
+   * @Description:
+   *   A memory-limited cache of decoded `gvar' data, so that loading a
+   *   glyph at new design coordinates only needs to compute the tuple
+   *   scalars and to sum up the deltas.  The least recently used entries
+   *   get discarded first.
+   *
+   * @Fields:
+   *   num_bytes ::
+   *     The memory currently used by the cache.
+   *
+   *   glyphs ::
+   *     An array of `gv_glyphcnt' entries, indexed by glyph index.
+   *
+   *   head ::
+   *     The most recently used entry.
+   *
+   *   tail ::
+   *     The least recently used entry.
+   */
+  typedef struct  GX_GlyphVarCacheRec_
+  {
+    FT_ULong      num_bytes;
+    GX_GlyphVar*  glyphs;
+
+    GX_GlyphVar   head;
+    GX_GlyphVar   tail;
+
+  } GX_GlyphVarCacheRec, *GX_GlyphVarCache;
+
+
   /**************************************************************************
    *
    * @Struct:
@@ -198,6 +333,11 @@ FT_BEGIN_HEADER
    *     contribution along each axis to the final interpolated font.
    *     `coords' holds the same values.
    *
+   *   coords_serial ::
+   *     A number that gets incremented whenever `normalizedcoords'
+   *     changes; it invalidates the region scalars cached in item
+   *     variation stores.
+   *
    *   mmvar ::
    *     Data from the `fvar' table.
    *
@@ -267,12 +407,23 @@ FT_BEGIN_HEADER
    *
    *   gvar_size ::
    *     The size of the `gvar' table.
+   *
+   *   glyph_delta_pool ::
+   *     A scratch buffer for `TT_Vary_Apply_Glyph_Deltas'.
+   *
+   *   glyph_delta_pool_size ::
+   *     The size of `glyph_delta_pool'.
+   *
+   *   glyph_var_cache ::
+   *     A cache of decoded glyph variation data; see
+   *     @GX_GlyphVarCacheRec.
    */
   typedef struct  GX_BlendRec_
   {
     FT_UInt         num_axis;
     FT_Fixed*       coords;
     FT_Fixed*       normalizedcoords;
+    FT_ULong        coords_serial;
 
     FT_MM_Var*      mmvar;
     FT_Offset       mmvar_len;
@@ -309,6 +460,8 @@ FT_BEGIN_HEADER
     FT_Byte*        glyph_delta_pool;
     FT_ULong        glyph_delta_pool_size;
 
+    GX_GlyphVarCacheRec  glyph_var_cache;
+
   } GX_BlendRec;
 
 
@@ -401,6 +554,13 @@ FT_BEGIN_HEADER
                               FT_Outline*  outline,
                               FT_Vector*   unrounded );
 
+  FT_LOCAL( FT_Error )
+  TT_Vary_Get_HAdvance( TT_Face    face,
+                        FT_UInt    glyph_index,
+                        FT_UInt    n_points,
+                        FT_UShort  advance,
+                        FT_Int*    alinear );
+
   FT_LOCAL( FT_Error )
   tt_hadvance_adjust( FT_Face  face,
                       FT_UInt  gindex,
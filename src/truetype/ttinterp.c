@@ -3094,6 +3094,65 @@
   }
 
 
+  /**************************************************************************
+   *
+   * Jump to the pre-computed target of the current IF or ELSE instruction,
+   * i.e., behave exactly like repeated calls to `SkipCode` that stop at the
+   * matching ELSE or EIF instruction.  Only the font and cvt programs have
+   * pre-computed branches (see `TT_Decode_Branches`); return FALSE if
+   * there is no suitable branch.
+   */
+  static FT_Bool
+  Skip_Branch( TT_ExecContext  exc )
+  {
+    TT_Face    face = exc->face;
+    TT_Branch  branches;
+    FT_ULong   min, max;
+
+
+    if ( exc->curRange == tt_coderange_font          &&
+         exc->code     == face->font_program         )
+    {
+      branches = face->font_program_branches;
+      max      = face->font_program_num_branches;
+    }
+    else if ( exc->curRange == tt_coderange_cvt     &&
+              exc->code     == face->cvt_program    )
+    {
+      branches = face->cvt_program_branches;
+      max      = face->cvt_program_num_branches;
+    }
+    else
+      return FALSE;
+
+    min = 0;
+    while ( min < max )
+    {
+      FT_ULong   mid    = ( min + max ) >> 1;
+      TT_Branch  branch = branches + mid;
+
+
+      if ( branch->ip < (FT_ULong)exc->IP )
+        min = mid + 1;
+      else if ( branch->ip > (FT_ULong)exc->IP )
+        max = mid;
+      else
+      {
+        if ( !branch->target )
+          return FALSE;
+
+        exc->IP     = (FT_Long)branch->target;
+        exc->opcode = exc->code[exc->IP];
+        exc->length = 1;
+
+        return TRUE;
+      }
+    }
+
+    return FALSE;
+  }
+
+
   /**************************************************************************
    *
    * IF[]:         IF test
@@ -3111,6 +3170,9 @@
     if ( args[0] != 0 )
       return;
 
+    if ( Skip_Branch( exc ) )
+      return;
+
     nIfs = 1;
     Out = 0;
 
@@ -3153,6 +3215,9 @@
     FT_Int  nIfs;
 
 
+    if ( Skip_Branch( exc ) )
+      return;
+
     nIfs = 1;
 
     do
@@ -3262,6 +3327,36 @@
    */
 
 
+  /* Get a private copy of function and instruction definitions */
+  /* shared with the face's program image before modifying them.  */
+  static FT_Bool
+  Unshare_Defs( TT_ExecContext  exc )
+  {
+    FT_Memory      memory = exc->memory;
+    FT_Error       error;
+    TT_DefRecord*  defs;
+
+
+    if ( !exc->shared_defs )
+      return SUCCESS;
+
+    if ( FT_QNEW_ARRAY( defs, exc->maxFDefs + exc->maxIDefs ) )
+    {
+      exc->error = error;
+      return FAILURE;
+    }
+
+    FT_ARRAY_COPY( defs, exc->FDefs, exc->numFDefs );
+    FT_ARRAY_COPY( defs + exc->maxFDefs, exc->IDefs, exc->numIDefs );
+
+    exc->FDefs       = defs;
+    exc->IDefs       = defs + exc->maxFDefs;
+    exc->shared_defs = FALSE;
+
+    return SUCCESS;
+  }
+
+
   /**************************************************************************
    *
    * FDEF[]:       Function DEFinition
@@ -3284,6 +3379,9 @@
       return;
     }
 
+    if ( Unshare_Defs( exc ) )
+      return;
+
     /* some font programs are broken enough to redefine functions! */
     /* We will then parse the current table.                       */
 
@@ -3573,6 +3671,9 @@
       return;
     }
 
+    if ( Unshare_Defs( exc ) )
+      return;
+
     /*  First of all, look for the same function in our table */
 
     def   = exc->IDefs;
@@ -6710,6 +6811,154 @@
   }
 
 
+  /**************************************************************************
+   *
+   * @Function:
+   *   TT_Decode_Branches
+   *
+   * @Description:
+   *   Pre-compute the targets of all IF and ELSE instructions in a code
+   *   range so that the interpreter doesn't have to scan the bytecode for
+   *   the matching ELSE and EIF instructions each time a branch is taken.
+   *
+   * @Input:
+   *   memory ::
+   *     A handle to the memory object used for allocation.
+   *
+   *   code ::
+   *     The bytecode.
+   *
+   *   size ::
+   *     The size of the bytecode in bytes.
+   *
+   * @Output:
+   *   abranches ::
+   *     An array of branches, sorted by offset.  To be freed with
+   *     `FT_FREE`.  `NULL` if there are no branches.
+   *
+   *   anum_branches ::
+   *     The number of elements in `abranches`.
+   *
+   * @Return:
+   *   FreeType error code.  0 means success.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Decode_Branches( FT_Memory       memory,
+                      const FT_Byte*  code,
+                      FT_ULong        size,
+                      TT_Branch      *abranches,
+                      FT_ULong       *anum_branches )
+  {
+    FT_Error   error    = FT_Err_Ok;
+    TT_Branch  branches = NULL;
+    FT_ULong*  stack    = NULL;
+    FT_ULong   num      = 0;
+    FT_ULong   top      = 0;
+    FT_ULong   ip;
+    FT_Int     pass;
+
+
+    *abranches     = NULL;
+    *anum_branches = 0;
+
+    /* The first pass counts the IF and ELSE instructions, the second */
+    /* one records them and resolves their targets, using a stack of  */
+    /* the still open branches.  As with `SkipCode`, the bytecode is  */
+    /* decoded linearly, which is the only way to reach the branches  */
+    /* we store; jumps into other positions use `SkipCode`.           */
+    for ( pass = 0; pass < 2; pass++ )
+    {
+      if ( pass == 1 )
+      {
+        if ( !num )
+          goto Exit;
+
+        if ( FT_QNEW_ARRAY( branches, num ) ||
+             FT_QNEW_ARRAY( stack, num )    )
+          goto Exit;
+
+        num = 0;
+      }
+
+      ip = 0;
+      while ( ip < size )
+      {
+        FT_Byte  opcode = code[ip];
+        FT_Long  length = opcode_length[opcode];
+
+
+        if ( length < 0 )
+        {
+          if ( ip + 1 >= size )
+            break;
+          length = 2 - length * code[ip + 1];
+        }
+
+        switch ( opcode )
+        {
+        case 0x58:    /* IF */
+          if ( pass == 1 )
+          {
+            branches[num].ip     = ip;
+            branches[num].target = 0;
+            stack[top++]         = num;
+          }
+          num++;
+          break;
+
+        case 0x1B:    /* ELSE */
+          if ( pass == 1 )
+          {
+            FT_ULong  n = top;
+
+
+            /* the first ELSE of a level is the target of its IF */
+            while ( n > 0 && code[branches[stack[n - 1]].ip] == 0x1B )
+              n--;
+            if ( n > 0 && !branches[stack[n - 1]].target )
+              branches[stack[n - 1]].target = ip;
+
+            branches[num].ip     = ip;
+            branches[num].target = 0;
+            stack[top++]         = num;
+          }
+          num++;
+          break;
+
+        case 0x59:    /* EIF */
+          /* close all ELSE instructions of the level and its IF */
+          while ( pass == 1 && top > 0 )
+          {
+            TT_Branch  branch = branches + stack[--top];
+
+
+            if ( !branch->target )
+              branch->target = ip;
+            if ( code[branch->ip] == 0x58 )
+              break;
+          }
+          break;
+
+        default:
+          break;
+        }
+
+        ip += (FT_ULong)length;
+      }
+    }
+
+    *abranches     = branches;
+    *anum_branches = num;
+    branches       = NULL;
+
+  Exit:
+    FT_FREE( stack );
+    FT_FREE( branches );
+
+    return error;
+  }
+
+
   /**************************************************************************
    *
    * RUN
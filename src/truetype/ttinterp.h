@@ -93,6 +93,30 @@ FT_BEGIN_HEADER
   } TT_DefRecord, *TT_DefArray;
 
 
+  /**************************************************************************
+   *
+   * The function and instruction definitions created by the font program.
+   * They don't depend on the size, thus the font program is executed only
+   * once per face, and this read-only image is shared by the execution
+   * contexts of all size objects.  A context gets a private copy as soon
+   * as the CVT program (re)defines a function or instruction.
+   */
+  typedef struct  TT_ProgramImageRec_
+  {
+    FT_UInt      interpreter_version;
+    FT_Bool      pedantic_hinting;
+
+    FT_UInt      numFDefs;
+    FT_UInt      numIDefs;
+    FT_UInt      maxFunc;
+    FT_UInt      maxIns;
+
+    TT_DefArray  defs;      /* `maxFunctionDefs` FDefs, followed by */
+                            /* `maxInstructionDefs` IDefs           */
+
+  } TT_ProgramImageRec, *TT_ProgramImage;
+
+
   /**************************************************************************
    *
    * Function types used by the interpreter, depending on various modes
@@ -219,6 +243,9 @@ FT_BEGIN_HEADER
     FT_UInt            maxFunc;   /* ! maximum function index    */
     FT_UInt            maxIns;    /* ! maximum instruction index */
 
+    FT_Bool            shared_defs;  /* `FDefs' and `IDefs' belong to */
+                                     /* the face's program image      */
+
     FT_Int             callTop,    /* @! top of call stack during execution */
                        callSize;   /*    size of call stack                 */
     TT_CallStack       callStack;  /*    call stack                         */
@@ -452,6 +479,13 @@ FT_BEGIN_HEADER
   TT_Run_Context( TT_ExecContext  exec,
                   TT_Size         size );
 
+  FT_LOCAL( FT_Error )
+  TT_Decode_Branches( FT_Memory       memory,
+                      const FT_Byte*  code,
+                      FT_ULong        size,
+                      TT_Branch      *abranches,
+                      FT_ULong       *anum_branches );
+
 
   /**************************************************************************
    *
@@ -131,6 +131,396 @@
   }
 
 
+  /*
+   * The results of the CVT program only depend on the rendering parameters
+   * of a size object.  Since it is common for applications to create
+   * several `FT_Size` objects with the same parameters (or to switch back
+   * and forth between a few sizes), we keep a small per-face cache of the
+   * graphics state, the CVT, the storage area, and the twilight zone as
+   * left by the CVT program.
+   *
+   * To be on the safe side, the function and instruction definitions
+   * active before running the CVT program are part of the key, and we
+   * don't cache anything if the CVT program itself changes them.
+   */
+
+  static void
+  tt_prep_cache_free_entry( FT_Memory          memory,
+                            TT_PrepCacheEntry  entry )
+  {
+    FT_FREE( entry->coords );
+    FT_FREE( entry->defs );
+    FT_FREE( entry->cvt );
+    FT_FREE( entry->twilight );
+  }
+
+
+  /* free the `prep' cache of a face */
+  static void
+  tt_prep_cache_done( TT_Face  face )
+  {
+    FT_Memory     memory = face->root.memory;
+    TT_PrepCache  cache  = (TT_PrepCache)face->prep_cache;
+    FT_UInt       i;
+
+
+    if ( !cache )
+      return;
+
+    for ( i = 0; i < cache->num_entries; i++ )
+      tt_prep_cache_free_entry( memory, cache->entries + i );
+
+    FT_FREE( face->prep_cache );
+  }
+
+
+  /* compare the function and instruction definitions of an entry */
+  /* with the ones currently active in the execution context      */
+  static FT_Bool
+  tt_prep_cache_same_defs( TT_PrepCacheEntry  entry,
+                           TT_ExecContext     exec )
+  {
+    TT_DefRecord*  def = entry->defs;
+    TT_DefRecord*  cur;
+    TT_DefRecord*  limit;
+
+
+    if ( entry->numFDefs != exec->numFDefs ||
+         entry->numIDefs != exec->numIDefs ||
+         entry->maxFunc  != exec->maxFunc  ||
+         entry->maxIns   != exec->maxIns   )
+      return FALSE;
+
+    cur   = exec->FDefs;
+    limit = cur + exec->numFDefs;
+
+    for ( ; cur < limit; cur++, def++ )
+      if ( cur->range  != def->range  ||
+           cur->start  != def->start  ||
+           cur->end    != def->end    ||
+           cur->opc    != def->opc    ||
+           cur->active != def->active )
+        return FALSE;
+
+    cur   = exec->IDefs;
+    limit = cur + exec->numIDefs;
+
+    for ( ; cur < limit; cur++, def++ )
+      if ( cur->range  != def->range  ||
+           cur->start  != def->start  ||
+           cur->end    != def->end    ||
+           cur->opc    != def->opc    ||
+           cur->active != def->active )
+        return FALSE;
+
+    return TRUE;
+  }
+
+
+  /* check whether an entry matches the parameters of the execution */
+  /* context, which must have been set up with `TT_Load_Context'    */
+  static FT_Bool
+  tt_prep_cache_match( TT_PrepCacheEntry  entry,
+                       TT_ExecContext     exec )
+  {
+    TT_Driver  driver = (TT_Driver)FT_FACE_DRIVER( exec->face );
+
+
+    if ( entry->x_ppem  != exec->metrics.x_ppem  ||
+         entry->y_ppem  != exec->metrics.y_ppem  ||
+         entry->x_scale != exec->metrics.x_scale ||
+         entry->y_scale != exec->metrics.y_scale )
+      return FALSE;
+
+    if ( entry->ttmetrics.x_ratio   != exec->tt_metrics.x_ratio   ||
+         entry->ttmetrics.y_ratio   != exec->tt_metrics.y_ratio   ||
+         entry->ttmetrics.ratio     != exec->tt_metrics.ratio     ||
+         entry->ttmetrics.scale     != exec->tt_metrics.scale     ||
+         entry->ttmetrics.ppem      != exec->tt_metrics.ppem      ||
+         entry->ttmetrics.rotated   != exec->tt_metrics.rotated   ||
+         entry->ttmetrics.stretched != exec->tt_metrics.stretched )
+      return FALSE;
+
+    if ( entry->point_size          != exec->pointSize              ||
+         entry->interpreter_version != driver->interpreter_version  ||
+         entry->grayscale           != exec->grayscale              ||
+         entry->pedantic_hinting    != exec->pedantic_hinting       )
+      return FALSE;
+
+#ifdef TT_SUPPORT_SUBPIXEL_HINTING_MINIMAL
+    if ( entry->mode != exec->mode )
+      return FALSE;
+#endif
+
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    {
+      GX_Blend  blend = exec->face->blend;
+
+
+      if ( entry->has_blend != FT_BOOL( blend ) )
+        return FALSE;
+
+      if ( entry->num_coords )
+      {
+        if ( !blend->normalizedcoords                                ||
+             ft_memcmp( entry->coords,
+                        blend->normalizedcoords,
+                        entry->num_coords * sizeof ( FT_Fixed ) ) )
+          return FALSE;
+      }
+      else if ( blend && blend->normalizedcoords )
+        return FALSE;
+    }
+#endif
+
+    return tt_prep_cache_same_defs( entry, exec );
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_prep_cache_restore
+   *
+   * @Description:
+   *   Look up the results of the CVT program for the current parameters of
+   *   a size object and, if available, copy them to the size object and
+   *   its execution context.
+   *
+   * @Input:
+   *   size ::
+   *     A handle to the size object.  `TT_Load_Context` must have been
+   *     called for its execution context.
+   *
+   * @Return:
+   *   True if the results were found.
+   */
+  static FT_Bool
+  tt_prep_cache_restore( TT_Size  size )
+  {
+    TT_Face         face  = (TT_Face)size->root.face;
+    TT_ExecContext  exec  = size->context;
+    TT_PrepCache    cache = (TT_PrepCache)face->prep_cache;
+
+    TT_PrepCacheEntryRec  found;
+    FT_UInt               i;
+
+
+    if ( !cache )
+      return FALSE;
+
+    for ( i = 0; i < cache->num_entries; i++ )
+      if ( tt_prep_cache_match( cache->entries + i, exec ) )
+        break;
+
+    if ( i == cache->num_entries )
+      return FALSE;
+
+    /* move the entry to the front */
+    found = cache->entries[i];
+    ft_memmove( cache->entries + 1,
+                cache->entries,
+                i * sizeof ( TT_PrepCacheEntryRec ) );
+    cache->entries[0] = found;
+
+    size->GS = found.GS;
+
+    FT_ARRAY_COPY( exec->cvt, found.cvt, exec->cvtSize );
+    FT_ARRAY_COPY( exec->storage, found.storage, exec->storeSize );
+    FT_ARRAY_COPY( size->twilight.org,
+                   found.twilight,
+                   2 * size->twilight.n_points );
+
+    cache->hits++;
+
+    FT_TRACE4(( "Reusing cached results of `prep' table.\n" ));
+
+    return TRUE;
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_prep_cache_prepare
+   *
+   * @Description:
+   *   Get a cache entry for the current parameters of a size object and
+   *   record its key.  This must be called right before running the CVT
+   *   program.
+   *
+   * @Input:
+   *   size ::
+   *     A handle to the size object.  `TT_Load_Context` must have been
+   *     called for its execution context.
+   *
+   * @Return:
+   *   The entry, or `NULL` if the results can't be cached.  In the latter
+   *   case, the CVT program should be run nevertheless.
+   */
+  static TT_PrepCacheEntry
+  tt_prep_cache_prepare( TT_Size  size )
+  {
+    TT_Face         face   = (TT_Face)size->root.face;
+    FT_Memory       memory = face->root.memory;
+    TT_ExecContext  exec   = size->context;
+    TT_Driver       driver = (TT_Driver)FT_FACE_DRIVER( face );
+    FT_Error        error;
+
+    TT_PrepCache       cache;
+    TT_PrepCacheEntry  entry;
+    FT_UInt            num_coords = 0;
+
+
+    /* don't interfere with a debugger that wants to single-step */
+    if ( exec->interpreter != (TT_Interpreter)TT_RunIns )
+      return NULL;
+
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    if ( face->blend && face->blend->normalizedcoords )
+      num_coords = face->blend->num_axis;
+#endif
+
+    if ( !face->prep_cache )
+    {
+      if ( FT_NEW( cache ) )
+        return NULL;
+
+      face->prep_cache = cache;
+    }
+    else
+      cache = (TT_PrepCache)face->prep_cache;
+
+    cache->misses++;
+
+    /* all buffer sizes are constant for a given face, */
+    /* thus we can recycle the least recently used one */
+    if ( cache->num_entries < TT_PREP_CACHE_MAX )
+    {
+      entry = cache->entries + cache->num_entries++;
+
+      if ( FT_QNEW_ARRAY( entry->defs, exec->maxFDefs + exec->maxIDefs ) ||
+           FT_QNEW_ARRAY( entry->cvt, exec->cvtSize + exec->storeSize )  ||
+           FT_QNEW_ARRAY( entry->twilight, 2 * size->twilight.n_points ) )
+        goto Fail;
+
+      entry->storage = entry->cvt + exec->cvtSize;
+    }
+    else
+      entry = cache->entries + TT_PREP_CACHE_MAX - 1;
+
+    /* the design coordinates might have been set up in the meantime */
+    if ( num_coords && !entry->coords                  &&
+         FT_QNEW_ARRAY( entry->coords, num_coords ) )
+      goto Fail;
+
+    entry->x_ppem  = exec->metrics.x_ppem;
+    entry->y_ppem  = exec->metrics.y_ppem;
+    entry->x_scale = exec->metrics.x_scale;
+    entry->y_scale = exec->metrics.y_scale;
+
+    entry->ttmetrics           = exec->tt_metrics;
+    entry->point_size          = exec->pointSize;
+    entry->interpreter_version = driver->interpreter_version;
+    entry->grayscale           = exec->grayscale;
+    entry->pedantic_hinting    = exec->pedantic_hinting;
+#ifdef TT_SUPPORT_SUBPIXEL_HINTING_MINIMAL
+    entry->mode                = exec->mode;
+#endif
+
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    entry->has_blend  = FT_BOOL( face->blend );
+    entry->num_coords = num_coords;
+    if ( num_coords )
+      FT_ARRAY_COPY( entry->coords,
+                     face->blend->normalizedcoords,
+                     num_coords );
+#endif
+
+    entry->numFDefs = exec->numFDefs;
+    entry->numIDefs = exec->numIDefs;
+    entry->maxFunc  = exec->maxFunc;
+    entry->maxIns   = exec->maxIns;
+
+    FT_ARRAY_COPY( entry->defs, exec->FDefs, exec->numFDefs );
+    FT_ARRAY_COPY( entry->defs + exec->numFDefs,
+                   exec->IDefs,
+                   exec->numIDefs );
+
+    return entry;
+
+  Fail:
+    /* the entry is always the last one */
+    tt_prep_cache_free_entry( memory, entry );
+    cache->num_entries--;
+
+    return NULL;
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_prep_cache_commit
+   *
+   * @Description:
+   *   Store the results of the CVT program in a cache entry returned by
+   *   @tt_prep_cache_prepare.  The entry gets discarded if the CVT
+   *   program failed or modified function or instruction definitions.
+   *
+   * @Input:
+   *   size ::
+   *     A handle to the size object.
+   *
+   *   entry ::
+   *     The cache entry.  Can be `NULL`.
+   *
+   *   error ::
+   *     The return value of the CVT program.
+   */
+  static void
+  tt_prep_cache_commit( TT_Size            size,
+                        TT_PrepCacheEntry  entry,
+                        FT_Error           error )
+  {
+    TT_Face         face   = (TT_Face)size->root.face;
+    FT_Memory       memory = face->root.memory;
+    TT_ExecContext  exec   = size->context;
+    TT_PrepCache    cache  = (TT_PrepCache)face->prep_cache;
+
+    TT_PrepCacheEntryRec  found;
+
+
+    if ( !entry )
+      return;
+
+    /* the entry is always the last one */
+    if ( error || !tt_prep_cache_same_defs( entry, exec ) )
+    {
+      tt_prep_cache_free_entry( memory, entry );
+      cache->num_entries--;
+
+      return;
+    }
+
+    entry->GS = size->GS;
+
+    FT_ARRAY_COPY( entry->cvt, exec->cvt, exec->cvtSize );
+    FT_ARRAY_COPY( entry->storage, exec->storage, exec->storeSize );
+    FT_ARRAY_COPY( entry->twilight,
+                   size->twilight.org,
+                   2 * size->twilight.n_points );
+
+    /* move the entry to the front */
+    found = *entry;
+    ft_memmove( cache->entries + 1,
+                cache->entries,
+                ( cache->num_entries - 1 ) *
+                  sizeof ( TT_PrepCacheEntryRec ) );
+    cache->entries[0] = found;
+  }
+
+
   /*
    * Fonts embedded in PDFs are made unique by prepending randomization
    * prefixes to their names: as defined in Section 5.5.3, 'Font Subsets',
@@ -742,18 +1132,19 @@
           goto Exit;
       }
 
-      /* `fpgm', `cvt', and `prep' are optional */
-      error = tt_face_load_cvt( face, stream );
-      if ( error && FT_ERR_NEQ( error, Table_Missing ) )
-        goto Exit;
-
-      error = tt_face_load_fpgm( face, stream );
-      if ( error && FT_ERR_NEQ( error, Table_Missing ) )
-        goto Exit;
-
-      error = tt_face_load_prep( face, stream );
-      if ( error && FT_ERR_NEQ( error, Table_Missing ) )
-        goto Exit;
+#ifdef TT_USE_BYTECODE_INTERPRETER
+      /* The optional `fpgm', `cvt', and `prep' tables are only needed */
+      /* for hinting; `tt_size_init_bytecode' loads them on demand.    */
+      /* However, `FT_Load_Glyph' checks the sizes of the programs to  */
+      /* decide whether the auto-hinter should be used instead.        */
+      if ( face->goto_table( face, TTAG_fpgm, stream,
+                             &face->font_program_size ) )
+        face->font_program_size = 0;
+
+      if ( face->goto_table( face, TTAG_prep, stream,
+                             &face->cvt_program_size ) )
+        face->cvt_program_size = 0;
+#endif
 
       /* Check the scalable flag based on `loca'. */
 #ifdef FT_CONFIG_OPTION_INCREMENTAL
@@ -840,6 +1231,8 @@
 
     tt_face_free_hdmx( face );
 
+    tt_face_done_outline_cache( face );
+
     /* freeing the CVT */
     FT_FREE( face->cvt );
     face->cvt_size = 0;
@@ -850,6 +1243,24 @@
     face->font_program_size = 0;
     face->cvt_program_size  = 0;
 
+    FT_FREE( face->font_program_branches );
+    FT_FREE( face->cvt_program_branches );
+    face->font_program_num_branches = 0;
+    face->cvt_program_num_branches  = 0;
+
+#ifdef TT_USE_BYTECODE_INTERPRETER
+    if ( face->program_image )
+    {
+      TT_ProgramImage  image = (TT_ProgramImage)face->program_image;
+
+
+      FT_FREE( image->defs );
+      FT_FREE( face->program_image );
+    }
+
+    tt_prep_cache_done( face );
+#endif
+
 #ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
     tt_done_blend( ttface );
     face->blend = NULL;
@@ -865,6 +1276,110 @@
 
 #ifdef TT_USE_BYTECODE_INTERPRETER
 
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_size_attach_program_image
+   *
+   * @Description:
+   *   Make the execution context of a size object use the function and
+   *   instruction definitions of the face's program image, if compatible.
+   *
+   * @Input:
+   *   size ::
+   *     A handle to the size object.
+   *
+   * @Return:
+   *   True if the program image is used, which means that the font
+   *   program need not be executed.
+   */
+  static FT_Bool
+  tt_size_attach_program_image( TT_Size  size )
+  {
+    TT_Face          face   = (TT_Face)size->root.face;
+    TT_ExecContext   exec   = size->context;
+    TT_Driver        driver = (TT_Driver)FT_FACE_DRIVER( face );
+    TT_ProgramImage  image  = (TT_ProgramImage)face->program_image;
+
+
+    /* a debugger might want to single-step the font program */
+    if ( !image                                                    ||
+         exec->interpreter          != (TT_Interpreter)TT_RunIns    ||
+         image->interpreter_version != driver->interpreter_version ||
+         image->pedantic_hinting    != exec->pedantic_hinting      )
+      return FALSE;
+
+    exec->FDefs = image->defs;
+    exec->IDefs = image->defs + exec->maxFDefs;
+
+    exec->numFDefs = image->numFDefs;
+    exec->numIDefs = image->numIDefs;
+
+    exec->maxFunc = image->maxFunc;
+    exec->maxIns  = image->maxIns;
+
+    exec->shared_defs = TRUE;
+
+    return TRUE;
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_face_new_program_image
+   *
+   * @Description:
+   *   Create the face's program image from the function and instruction
+   *   definitions of a successful run of the font program.  Nothing
+   *   happens if there is already a program image.
+   *
+   * @Input:
+   *   size ::
+   *     A handle to the size object that has executed the font program.
+   */
+  static void
+  tt_face_new_program_image( TT_Size  size )
+  {
+    TT_Face          face   = (TT_Face)size->root.face;
+    FT_Memory        memory = face->root.memory;
+    TT_ExecContext   exec   = size->context;
+    TT_Driver        driver = (TT_Driver)FT_FACE_DRIVER( face );
+    TT_ProgramImage  image;
+    FT_Error         error;
+
+
+    if ( face->program_image                               ||
+         exec->interpreter != (TT_Interpreter)TT_RunIns )
+      return;
+
+    /* the program image is an optimization; ignore allocation errors */
+    if ( FT_QNEW( image ) )
+      return;
+
+    if ( FT_QNEW_ARRAY( image->defs, exec->maxFDefs + exec->maxIDefs ) )
+    {
+      FT_FREE( image );
+      return;
+    }
+
+    FT_ARRAY_COPY( image->defs, exec->FDefs, exec->numFDefs );
+    FT_ARRAY_COPY( image->defs + exec->maxFDefs,
+                   exec->IDefs,
+                   exec->numIDefs );
+
+    image->interpreter_version = driver->interpreter_version;
+    image->pedantic_hinting    = exec->pedantic_hinting;
+
+    image->numFDefs = exec->numFDefs;
+    image->numIDefs = exec->numIDefs;
+    image->maxFunc  = exec->maxFunc;
+    image->maxIns   = exec->maxIns;
+
+    face->program_image = image;
+  }
+
+
   /**************************************************************************
    *
    * @Function:
@@ -905,13 +1420,22 @@
       exec->pts.n_points   = 0;
       exec->pts.n_contours = 0;
 
-      FT_TRACE4(( "Executing `fpgm' table.\n" ));
-      error = TT_Run_Context( exec, size );
-      FT_TRACE4(( error ? "  failed (error code 0x%x)\n" : "",
-                  error ));
+      /* the definitions might already be in the face's program image */
+      if ( exec->shared_defs )
+        error = FT_Err_Ok;
+      else
+      {
+        FT_TRACE4(( "Executing `fpgm' table.\n" ));
+        error = TT_Run_Context( exec, size );
+        FT_TRACE4(( error ? "  failed (error code 0x%x)\n" : "",
+                    error ));
 
-      if ( !error )
-        TT_Save_Context( exec, size );
+        if ( !error )
+        {
+          TT_Save_Context( exec, size );
+          tt_face_new_program_image( size );
+        }
+      }
     }
     else
       error = FT_Err_Ok;
@@ -940,10 +1464,11 @@
   FT_LOCAL_DEF( FT_Error )
   tt_size_run_prep( TT_Size  size )
   {
-    TT_Face         face = (TT_Face)size->root.face;
-    TT_ExecContext  exec = size->context;
-    FT_Error        error;
-    FT_UInt         i;
+    TT_Face            face = (TT_Face)size->root.face;
+    TT_ExecContext     exec = size->context;
+    TT_PrepCacheEntry  entry;
+    FT_Error           error;
+    FT_UInt            i;
 
 
     /* set default GS, twilight points, and storage */
@@ -956,6 +1481,16 @@
 
     TT_Load_Context( exec, face, size );
 
+    /* reuse the results of an earlier run with the same parameters */
+    if ( face->cvt_program_size > 0 && tt_prep_cache_restore( size ) )
+    {
+      TT_Clear_CodeRange( exec, tt_coderange_glyph );
+
+      size->cvt_ready = FT_Err_Ok;
+
+      return FT_Err_Ok;
+    }
+
     /* clear storage area */
     FT_ARRAY_ZERO( exec->storage, exec->storeSize );
 
@@ -986,6 +1521,8 @@
       exec->pts.n_points   = 0;
       exec->pts.n_contours = 0;
 
+      entry = tt_prep_cache_prepare( size );
+
       FT_TRACE4(( "Executing `prep' table.\n" ));
       error = TT_Run_Context( exec, size );
       FT_TRACE4(( error ? "  failed (error code 0x%x)\n" : "",
@@ -993,6 +1530,8 @@
 
       if ( !error )
         TT_Save_Context( exec, size );
+
+      tt_prep_cache_commit( size, entry, error );
     }
     else
       error = FT_Err_Ok;
@@ -1013,7 +1552,11 @@
     if ( exec )
     {
       FT_FREE( exec->stack );
-      FT_FREE( exec->FDefs );
+
+      if ( exec->shared_defs )
+        exec->FDefs = NULL;
+      else
+        FT_FREE( exec->FDefs );
 
       TT_Done_Context( exec );
       size->context = NULL;
@@ -1024,6 +1567,68 @@
   }
 
 
+  /* Load the `cvt', `fpgm', and `prep' tables and decode the branches */
+  /* of the programs.  This is delayed until the first size object     */
+  /* needs the bytecode interpreter, since many clients (for example,  */
+  /* font enumeration) never hint a glyph.                             */
+  static FT_Error
+  tt_face_load_bytecode( TT_Face  face )
+  {
+    FT_Stream  stream = face->root.stream;
+    FT_Memory  memory = face->root.memory;
+    FT_Error   error;
+
+
+    if ( face->bytecode_loaded )
+      return FT_Err_Ok;
+
+    error = tt_face_load_cvt( face, stream );
+    if ( error && FT_ERR_NEQ( error, Table_Missing ) )
+      goto Fail;
+
+    error = tt_face_load_fpgm( face, stream );
+    if ( error && FT_ERR_NEQ( error, Table_Missing ) )
+      goto Fail;
+
+    error = tt_face_load_prep( face, stream );
+    if ( error && FT_ERR_NEQ( error, Table_Missing ) )
+      goto Fail;
+
+    error = TT_Decode_Branches( memory,
+                                face->font_program,
+                                face->font_program_size,
+                                &face->font_program_branches,
+                                &face->font_program_num_branches );
+    if ( error )
+      goto Fail;
+
+    error = TT_Decode_Branches( memory,
+                                face->cvt_program,
+                                face->cvt_program_size,
+                                &face->cvt_program_branches,
+                                &face->cvt_program_num_branches );
+    if ( error )
+      goto Fail;
+
+    face->bytecode_loaded = TRUE;
+
+    return FT_Err_Ok;
+
+  Fail:
+    /* start from scratch if we get called again */
+    FT_FREE( face->cvt );
+    face->cvt_size = 0;
+
+    FT_FRAME_RELEASE( face->font_program );
+    FT_FRAME_RELEASE( face->cvt_program );
+
+    FT_FREE( face->font_program_branches );
+    face->font_program_num_branches = 0;
+
+    return error;
+  }
+
+
   /* Initialize bytecode-related fields in the size object.       */
   /* We do this only if bytecode interpretation is really needed. */
   FT_LOCAL_DEF( FT_Error )
@@ -1039,6 +1644,10 @@
     TT_ExecContext  exec;
 
 
+    error = tt_face_load_bytecode( face );
+    if ( error )
+      return error;
+
     exec = TT_New_Context( (TT_Driver)face->root.driver );
     if ( !exec )
       return FT_THROW( Could_Not_Find_Context );
@@ -1050,16 +1659,21 @@
     exec->maxFDefs = maxp->maxFunctionDefs;
     exec->maxIDefs = maxp->maxInstructionDefs;
 
-    if ( FT_NEW_ARRAY( exec->FDefs, exec->maxFDefs + exec->maxIDefs ) )
-      goto Fail;
+    /* if another size has already run the font program, */
+    /* we simply share the resulting definitions         */
+    if ( !tt_size_attach_program_image( size ) )
+    {
+      if ( FT_NEW_ARRAY( exec->FDefs, exec->maxFDefs + exec->maxIDefs ) )
+        goto Fail;
 
-    exec->IDefs = exec->FDefs + exec->maxFDefs;
+      exec->IDefs = exec->FDefs + exec->maxFDefs;
 
-    exec->numFDefs = 0;
-    exec->numIDefs = 0;
+      exec->numFDefs = 0;
+      exec->numIDefs = 0;
 
-    exec->maxFunc = 0;
-    exec->maxIns  = 0;
+      exec->maxFunc = 0;
+      exec->maxIns  = 0;
+    }
 
     /* We reserve extra elements on the stack to deal with broken fonts. */
     /*                                                                   */
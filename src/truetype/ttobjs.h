@@ -197,6 +197,73 @@ FT_BEGIN_HEADER
   } TT_Size_Metrics;
 
 
+#ifdef TT_USE_BYTECODE_INTERPRETER
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   TT_PrepCacheEntryRec
+   *
+   * @Description:
+   *   The state left by the CVT program for a given set of rendering
+   *   parameters.
+   */
+  typedef struct  TT_PrepCacheEntryRec_
+  {
+    /* the key */
+    FT_Pos                 x_ppem;
+    FT_Pos                 y_ppem;
+    FT_Fixed               x_scale;
+    FT_Fixed               y_scale;
+    TT_Size_Metrics        ttmetrics;
+    FT_Long                point_size;
+    FT_UInt                interpreter_version;
+    FT_Bool                grayscale;
+    FT_Render_Mode         mode;
+    FT_Bool                pedantic_hinting;
+    FT_Bool                has_blend;
+    FT_UInt                num_coords;
+    FT_Fixed*              coords;      /* normalized design coordinates */
+
+    FT_UInt                numFDefs;
+    FT_UInt                numIDefs;
+    FT_UInt                maxFunc;
+    FT_UInt                maxIns;
+    struct TT_DefRecord_*  defs;        /* function and instruction defs */
+
+    /* the value */
+    TT_GraphicsState       GS;
+    FT_Long*               cvt;
+    FT_Long*               storage;
+    FT_Vector*             twilight;    /* `org' followed by `cur' */
+
+  } TT_PrepCacheEntryRec, *TT_PrepCacheEntry;
+
+
+#define TT_PREP_CACHE_MAX  8
+
+  /**************************************************************************
+   *
+   * @Struct:
+   *   TT_PrepCacheRec
+   *
+   * @Description:
+   *   A per-face cache of CVT program results, shared by all size objects
+   *   of the face.  The entries are kept in most-recently-used order.
+   */
+  typedef struct  TT_PrepCacheRec_
+  {
+    FT_UInt               num_entries;
+    TT_PrepCacheEntryRec  entries[TT_PREP_CACHE_MAX];
+
+    FT_ULong              hits;      /* number of avoided `prep' runs */
+    FT_ULong              misses;
+
+  } TT_PrepCacheRec, *TT_PrepCache;
+
+#endif /* TT_USE_BYTECODE_INTERPRETER */
+
+
   /**************************************************************************
    *
    * TrueType size class.
@@ -248,6 +315,9 @@ FT_BEGIN_HEADER
 
     FT_UInt  interpreter_version;
 
+    FT_ULong  outline_cache_size;  /* per-face limit in bytes */
+    FT_ULong  gvar_cache_size;     /* per-face limit in bytes */
+
   } TT_DriverRec;
 
 
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <freetype/freetype.h>
+#include <freetype/ftcache.h>
+#include <ft2build.h>
+
+
+  /* more references than a node's `FT_Short' reference count can hold */
+#define NUM_GLYPHS  40000
+
+
+static FT_Error
+face_requester( FTC_FaceID  face_id,
+                FT_Library  library,
+                FT_Pointer  req_data,
+                FT_Face    *aface )
+{
+  (void)req_data;
+
+  return FT_New_Face( library, (const char*)face_id, 0, aface );
+}
+
+
+int
+main( void )
+{
+  FT_Library      library;
+  FTC_Manager     manager = NULL;
+  FTC_ImageCache  image_cache;
+  FTC_SBitCache   sbit_cache;
+  FTC_ScalerRec   scaler;
+  FT_UInt*        gindices = NULL;
+  FT_Glyph*       glyphs   = NULL;
+  FTC_SBit*       sbits    = NULL;
+  FTC_Node*       nodes    = NULL;
+  FT_Error        error;
+  FT_UInt         nn;
+
+  /*
+   * We assume that `FREETYPE_TESTS_DATA_DIR` was set by `meson test`.
+   * Otherwise we default to `../tests/data`.
+   */
+  const char*  testdata_dir = getenv( "FREETYPE_TESTS_DATA_DIR" );
+  char         filepath[FILENAME_MAX];
+  int          ret = 0;
+
+
+  snprintf( filepath, sizeof( filepath ), "%s/%s",
+            testdata_dir ? testdata_dir : "../tests/data",
+            "As.I.Lay.Dying.ttf" );
+
+  FT_Init_FreeType( &library );
+
+  gindices = (FT_UInt*)malloc( NUM_GLYPHS * sizeof ( *gindices ) );
+  glyphs   = (FT_Glyph*)malloc( NUM_GLYPHS * sizeof ( *glyphs ) );
+  sbits    = (FTC_SBit*)malloc( NUM_GLYPHS * sizeof ( *sbits ) );
+  nodes    = (FTC_Node*)malloc( NUM_GLYPHS * sizeof ( *nodes ) );
+  if ( !gindices || !glyphs || !sbits || !nodes )
+  {
+    fprintf( stderr, "Out of memory\n" );
+    ret = 1;
+    goto Exit;
+  }
+
+  if ( FTC_Manager_New( library, 0, 0, 0,
+                        face_requester, NULL, &manager ) ||
+       FTC_ImageCache_New( manager, &image_cache )       ||
+       FTC_SBitCache_New( manager, &sbit_cache )         )
+  {
+    fprintf( stderr, "Could not create caches\n" );
+    ret = 1;
+    goto Exit;
+  }
+
+  scaler.face_id = (FTC_FaceID)filepath;
+  scaler.width   = 16;
+  scaler.height  = 16;
+  scaler.pixel   = 1;
+  scaler.x_res   = 0;
+  scaler.y_res   = 0;
+
+  for ( nn = 0; nn < NUM_GLYPHS; nn++ )
+    gindices[nn] = 1;
+
+  /* a run of identical glyphs must be refused, not overflow the */
+  /* nodes' reference counts, whether or not nodes are returned  */
+  error = FTC_ImageCache_LookupGlyphs( image_cache, &scaler,
+                                       FT_LOAD_DEFAULT,
+                                       NUM_GLYPHS, gindices,
+                                       glyphs, NULL );
+  if ( FT_ERROR_BASE( error ) != FT_Err_Invalid_Argument )
+  {
+    fprintf( stderr, "Image cache accepted %d identical glyphs (%d)\n",
+             NUM_GLYPHS, error );
+    ret = 1;
+  }
+
+  error = FTC_SBitCache_LookupGlyphs( sbit_cache, &scaler,
+                                      FT_LOAD_DEFAULT,
+                                      NUM_GLYPHS, gindices,
+                                      sbits, nodes );
+  if ( FT_ERROR_BASE( error ) != FT_Err_Invalid_Argument )
+  {
+    fprintf( stderr, "SBit cache accepted %d identical glyphs (%d)\n",
+             NUM_GLYPHS, error );
+    ret = 1;
+  }
+
+  for ( nn = 0; nn < NUM_GLYPHS; nn++ )
+  {
+    if ( sbits[nn] || nodes[nn] )
+    {
+      fprintf( stderr, "Element %u not reset after failure\n", nn );
+      ret = 1;
+      break;
+    }
+  }
+
+  /* the largest possible run still succeeds and can be released */
+  error = FTC_ImageCache_LookupGlyphs( image_cache, &scaler,
+                                       FT_LOAD_DEFAULT,
+                                       0x7FFF, gindices,
+                                       glyphs, nodes );
+  if ( error )
+  {
+    fprintf( stderr, "Image cache refused %d identical glyphs (%d)\n",
+             0x7FFF, error );
+    ret = 1;
+  }
+  else
+  {
+    for ( nn = 0; nn < 0x7FFF; nn++ )
+      FTC_Node_Unref( nodes[nn], manager );
+  }
+
+  /* all nodes must be releasable again */
+  FTC_Manager_Reset( manager );
+
+Exit:
+  if ( manager )
+    FTC_Manager_Done( manager );
+  FT_Done_FreeType( library );
+
+  free( gindices );
+  free( glyphs );
+  free( sbits );
+  free( nodes );
+
+  return ret;
+}
+
+/* EOF */
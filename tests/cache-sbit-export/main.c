@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <freetype/freetype.h>
+#include <freetype/ftcache.h>
+#include <ft2build.h>
+
+
+  /* a single gray bitmap of the maximum width the sbit cache can hold */
+#define GLYPH_INDEX   3
+#define GLYPH_WIDTH   255
+#define GLYPH_HEIGHT  2
+
+#define HEADER_SIZE   14
+#define RECORD_SIZE   14
+#define DATA_SIZE     ( HEADER_SIZE + RECORD_SIZE + \
+                        GLYPH_WIDTH * GLYPH_HEIGHT )
+
+
+static FT_Error
+face_requester( FTC_FaceID  face_id,
+                FT_Library  library,
+                FT_Pointer  req_data,
+                FT_Face    *aface )
+{
+  (void)req_data;
+
+  return FT_New_Face( library, (const char*)face_id, 0, aface );
+}
+
+
+static unsigned char*
+put_ulong( unsigned char*  p,
+           unsigned long   value )
+{
+  *p++ = (unsigned char)( value >> 24 );
+  *p++ = (unsigned char)( value >> 16 );
+  *p++ = (unsigned char)( value >> 8 );
+  *p++ = (unsigned char)value;
+
+  return p;
+}
+
+
+  /* serialize the bitmap as `FTC_SBitCache_Export' would */
+static void
+make_data( FT_Library      library,
+           unsigned char*  data )
+{
+  unsigned char*  p = data;
+  FT_Int          major, minor, patch;
+  int             i;
+
+
+  FT_Library_Version( library, &major, &minor, &patch );
+
+  p = put_ulong( p, FT_MAKE_TAG( 'F', 'T', 'C', 'S' ) );
+  *p++ = 0;
+  *p++ = 1;
+  p = put_ulong( p, (unsigned long)( ( major << 16 ) |
+                                     ( minor << 8 )  |
+                                     patch           ) );
+  p = put_ulong( p, 1 );
+
+  p = put_ulong( p, GLYPH_INDEX );
+  *p++ = GLYPH_WIDTH;
+  *p++ = GLYPH_HEIGHT;
+  *p++ = 1;                                /* left      */
+  *p++ = GLYPH_HEIGHT;                     /* top       */
+  *p++ = FT_PIXEL_MODE_GRAY;
+  *p++ = 255;                              /* max_grays */
+  *p++ = 0;                                /* pitch     */
+  *p++ = GLYPH_WIDTH;
+  *p++ = 20;                               /* xadvance  */
+  *p++ = 0;                                /* yadvance  */
+
+  for ( i = 0; i < GLYPH_WIDTH * GLYPH_HEIGHT; i++ )
+    *p++ = (unsigned char)i;
+}
+
+
+int
+main( void )
+{
+  FT_Library      library;
+  FTC_Manager     manager = NULL;
+  FTC_SBitCache   sbit_cache;
+  FTC_ScalerRec   scaler;
+  FTC_SBit        sbit;
+  FT_ULong        length;
+  FT_Error        error;
+  unsigned char   data[DATA_SIZE];
+  unsigned char   exported[DATA_SIZE];
+
+  /*
+   * We assume that `FREETYPE_TESTS_DATA_DIR` was set by `meson test`.
+   * Otherwise we default to `../tests/data`.
+   */
+  const char*  testdata_dir = getenv( "FREETYPE_TESTS_DATA_DIR" );
+  char         filepath[FILENAME_MAX];
+  int          ret = 0;
+
+
+  snprintf( filepath, sizeof( filepath ), "%s/%s",
+            testdata_dir ? testdata_dir : "../tests/data",
+            "As.I.Lay.Dying.ttf" );
+
+  FT_Init_FreeType( &library );
+
+  if ( FTC_Manager_New( library, 0, 0, 0,
+                        face_requester, NULL, &manager ) ||
+       FTC_SBitCache_New( manager, &sbit_cache )         )
+  {
+    fprintf( stderr, "Could not create cache\n" );
+    ret = 1;
+    goto Exit;
+  }
+
+  scaler.face_id = (FTC_FaceID)filepath;
+  scaler.width   = 16;
+  scaler.height  = 16;
+  scaler.pixel   = 1;
+  scaler.x_res   = 0;
+  scaler.y_res   = 0;
+
+  make_data( library, data );
+
+  error = FTC_SBitCache_Import( sbit_cache, &scaler, FT_LOAD_DEFAULT,
+                                data, sizeof ( data ) );
+  if ( error )
+  {
+    fprintf( stderr, "Could not import %d-wide bitmap (%d)\n",
+             GLYPH_WIDTH, error );
+    ret = 1;
+    goto Exit;
+  }
+
+  /* the imported bitmap must be served without loading the glyph */
+  error = FTC_SBitCache_LookupScaler( sbit_cache, &scaler,
+                                      FT_LOAD_DEFAULT, GLYPH_INDEX,
+                                      &sbit, NULL );
+  if ( error                         ||
+       sbit->width  != GLYPH_WIDTH   ||
+       sbit->height != GLYPH_HEIGHT  ||
+       !sbit->buffer                 )
+  {
+    fprintf( stderr, "Imported bitmap not found (%d)\n", error );
+    ret = 1;
+    goto Exit;
+  }
+
+  length = sizeof ( exported );
+  error  = FTC_SBitCache_Export( sbit_cache, &scaler, FT_LOAD_DEFAULT,
+                                 exported, &length );
+  if ( error                                ||
+       length != sizeof ( data )            ||
+       memcmp( exported, data, length ) != 0 )
+  {
+    fprintf( stderr, "Exported data differs from imported data\n" );
+    ret = 1;
+  }
+
+Exit:
+  if ( manager )
+    FTC_Manager_Done( manager );
+  FT_Done_FreeType( library );
+
+  return ret;
+}
+
+/* EOF */